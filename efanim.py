@@ -0,0 +1,380 @@
+#!/usr/bin/python3
+
+# MIT License
+#
+# Copyright 2024 Eurofurence e.V.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the “Software”),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+
+"""
+Encoder, decoder and validator for LED animations played by the AnimatePlayer
+state. The binary format is documented in lib/EFLed/EFLedAnimation.h.
+
+Animations are described as JSON:
+
+    {
+        "name": "example",
+        "loop": true,
+        "loop_start": 0,
+        "frames": [
+            {"duration": 40, "leds": ["#ff0000", "#000000", ... 17 colors]},
+            ...
+        ]
+    }
+
+Example usage:
+
+    ./efanim.py example -o example.json
+    ./efanim.py encode example.json -o example.efan
+    ./efanim.py pack example.efan -o anim.bin
+    ./efanim.py validate anim.bin
+    ./efanim.py bench example.efan
+"""
+
+import argparse
+import colorsys
+import json
+import struct
+import sys
+import time
+
+LED_NUM = 17
+
+PARTITION_MAGIC = b"EFAP"
+ANIMATION_MAGIC = b"EFAN"
+VERSION = 1
+PARTITION_HEADER = struct.Struct("<4sBBH")
+DIRECTORY_ENTRY = struct.Struct("<II")
+ANIMATION_HEADER = struct.Struct("<4sBBHHH16s")
+FRAME_HEADER = struct.Struct("<HBB")
+NAME_LEN = 16
+
+FLAG_LOOP = 0x01
+FRAME_KEY = 0
+FRAME_DELTA = 1
+
+# Size of the "anim" partition in partitions.csv
+PARTITION_SIZE_DEFAULT = 0x180000
+
+
+class FormatError(Exception):
+    pass
+
+
+def parse_color(value):
+    """Parses a color given as '#rrggbb' string or [r, g, b] list"""
+    if isinstance(value, str):
+        value = value.lstrip("#")
+        if len(value) != 6:
+            raise FormatError(f"Invalid color: #{value}")
+        return tuple(bytes.fromhex(value))
+    if len(value) != 3 or not all(0 <= c <= 255 for c in value):
+        raise FormatError(f"Invalid color: {value}")
+    return tuple(value)
+
+
+def encode(animation, keyframe_interval=0):
+    """Encodes an animation description into its binary representation"""
+    frames = animation["frames"]
+    loop = animation.get("loop", True)
+    loop_start = animation.get("loop_start", 0)
+    name = animation.get("name", "").encode("utf-8")[:NAME_LEN]
+
+    if not 0 < len(frames) <= 0xFFFF:
+        raise FormatError("Animation must have between 1 and 65535 frames")
+    if not 0 <= loop_start < len(frames):
+        raise FormatError("loop_start must reference an existing frame")
+
+    data = bytearray(ANIMATION_HEADER.pack(
+        ANIMATION_MAGIC, VERSION, FLAG_LOOP if loop else 0, len(frames), loop_start, 0, name
+    ))
+
+    previous = None
+    for idx, frame in enumerate(frames):
+        leds = [parse_color(c) for c in frame["leds"]]
+        if len(leds) != LED_NUM:
+            raise FormatError(f"Frame {idx} must have {LED_NUM} LEDs")
+        duration = frame.get("duration", 40)
+        if not 0 <= duration <= 0xFFFF:
+            raise FormatError(f"Frame {idx} has invalid duration")
+
+        changed = [] if previous is None else [i for i in range(LED_NUM) if leds[i] != previous[i]]
+        force_key = (
+            previous is None
+            or idx == loop_start
+            or (keyframe_interval > 0 and idx % keyframe_interval == 0)
+        )
+        if force_key or len(changed) * 4 >= LED_NUM * 3:
+            data += FRAME_HEADER.pack(duration, FRAME_KEY, LED_NUM)
+            for color in leds:
+                data += bytes(color)
+        else:
+            data += FRAME_HEADER.pack(duration, FRAME_DELTA, len(changed))
+            for i in changed:
+                data += bytes((i, *leds[i]))
+        previous = leds
+
+    return bytes(data)
+
+
+def decode(data):
+    """Decodes and validates a binary animation. Returns its description."""
+    if len(data) < ANIMATION_HEADER.size:
+        raise FormatError("Animation is truncated")
+    magic, version, flags, num_frames, loop_start, _, name = ANIMATION_HEADER.unpack_from(data)
+    if magic != ANIMATION_MAGIC:
+        raise FormatError("Invalid animation magic")
+    if version != VERSION:
+        raise FormatError(f"Unsupported version: {version}")
+    if num_frames == 0:
+        raise FormatError("Animation has no frames")
+
+    frames = []
+    types = []
+    pos = ANIMATION_HEADER.size
+    leds = [(0, 0, 0)] * LED_NUM
+    for idx in range(num_frames):
+        if pos + FRAME_HEADER.size > len(data):
+            raise FormatError(f"Frame {idx} exceeds animation data")
+        duration, frame_type, entries = FRAME_HEADER.unpack_from(data, pos)
+        pos += FRAME_HEADER.size
+
+        if frame_type == FRAME_KEY:
+            if entries != LED_NUM:
+                raise FormatError(f"Keyframe {idx} has invalid size")
+            if pos + entries * 3 > len(data):
+                raise FormatError(f"Frame {idx} exceeds animation data")
+            leds = [tuple(data[pos + i * 3:pos + i * 3 + 3]) for i in range(LED_NUM)]
+            pos += entries * 3
+        elif frame_type == FRAME_DELTA:
+            if idx == 0:
+                raise FormatError("First frame must be a keyframe")
+            if pos + entries * 4 > len(data):
+                raise FormatError(f"Frame {idx} exceeds animation data")
+            leds = list(leds)
+            for i in range(entries):
+                led, r, g, b = data[pos:pos + 4]
+                if led >= LED_NUM:
+                    raise FormatError(f"Frame {idx} references invalid LED {led}")
+                leds[led] = (r, g, b)
+                pos += 4
+        else:
+            raise FormatError(f"Frame {idx} has unknown type {frame_type}")
+
+        types.append(frame_type)
+        frames.append({"duration": duration, "leds": ["#%02x%02x%02x" % c for c in leds]})
+
+    loop = bool(flags & FLAG_LOOP)
+    if loop and (loop_start >= num_frames or types[loop_start] != FRAME_KEY):
+        raise FormatError("Loop start must reference a keyframe")
+    if pos != len(data):
+        raise FormatError(f"{len(data) - pos} trailing bytes after last frame")
+
+    return {
+        "name": name.rstrip(b"\0").decode("utf-8", errors="replace"),
+        "loop": loop,
+        "loop_start": loop_start,
+        "frames": frames,
+        "keyframes": types.count(FRAME_KEY),
+    }
+
+
+def pack(animations, partition_size=PARTITION_SIZE_DEFAULT):
+    """Builds a partition image holding all given binary animations"""
+    if not 0 < len(animations) <= 255:
+        raise FormatError("Partition must hold between 1 and 255 animations")
+
+    image = bytearray(PARTITION_HEADER.pack(PARTITION_MAGIC, VERSION, len(animations), 0))
+    offset = PARTITION_HEADER.size + DIRECTORY_ENTRY.size * len(animations)
+    for animation in animations:
+        image += DIRECTORY_ENTRY.pack(offset, len(animation))
+        offset += len(animation)
+    for animation in animations:
+        image += animation
+
+    if len(image) > partition_size:
+        raise FormatError(f"Image size {len(image)} exceeds partition size {partition_size}")
+    return bytes(image)
+
+
+def unpack(image):
+    """Splits a partition image into its binary animations"""
+    if len(image) < PARTITION_HEADER.size:
+        raise FormatError("Partition image is truncated")
+    magic, version, count, _ = PARTITION_HEADER.unpack_from(image)
+    if magic != PARTITION_MAGIC:
+        raise FormatError("Invalid partition magic")
+    if version != VERSION:
+        raise FormatError(f"Unsupported version: {version}")
+
+    animations = []
+    for idx in range(count):
+        pos = PARTITION_HEADER.size + idx * DIRECTORY_ENTRY.size
+        if pos + DIRECTORY_ENTRY.size > len(image):
+            raise FormatError("Directory is truncated")
+        offset, size = DIRECTORY_ENTRY.unpack_from(image, pos)
+        if offset + size > len(image):
+            raise FormatError(f"Animation {idx} exceeds partition image")
+        animations.append(image[offset:offset + size])
+    return animations
+
+
+def load(path):
+    """Loads either a single animation or all animations from a partition image"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] == PARTITION_MAGIC:
+        return unpack(data)
+    return [data]
+
+
+def cmd_encode(args):
+    with open(args.input) as f:
+        animation = json.load(f)
+    data = encode(animation, args.keyframe_interval)
+    decode(data)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print(f"{args.output}: {len(animation['frames'])} frames, {len(data)} bytes")
+
+
+def cmd_decode(args):
+    animations = [decode(data) for data in load(args.input)]
+    for animation in animations:
+        del animation["keyframes"]
+    result = animations[0] if len(animations) == 1 else animations
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(result, f, indent=2)
+    else:
+        json.dump(result, sys.stdout, indent=2)
+        print()
+
+
+def cmd_validate(args):
+    ok = True
+    for idx, data in enumerate(load(args.input)):
+        try:
+            animation = decode(data)
+            duration = sum(frame["duration"] for frame in animation["frames"])
+            print(
+                f"[{idx}] {animation['name'] or '(unnamed)'}: {len(animation['frames'])} frames "
+                f"({animation['keyframes']} keyframes), {duration} ms, {len(data)} bytes, "
+                f"loop={animation['loop']}"
+            )
+        except FormatError as e:
+            print(f"[{idx}] INVALID: {e}")
+            ok = False
+    return 0 if ok else 1
+
+
+def cmd_pack(args):
+    animations = []
+    for path in args.inputs:
+        with open(path, "rb") as f:
+            data = f.read()
+        decode(data)
+        animations.append(data)
+    image = pack(animations, int(args.partition_size, 0))
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print(f"{args.output}: {len(animations)} animations, {len(image)} bytes")
+
+
+def cmd_bench(args):
+    for idx, data in enumerate(load(args.input)):
+        animation = decode(data)
+        num_frames = len(animation["frames"])
+        start = time.perf_counter()
+        for _ in range(args.iterations):
+            decode(data)
+        elapsed = time.perf_counter() - start
+        raw_size = num_frames * LED_NUM * 3
+        print(
+            f"[{idx}] {animation['name'] or '(unnamed)'}: {len(data)} bytes, "
+            f"{len(data) / num_frames:.1f} bytes/frame, "
+            f"{100.0 * len(data) / raw_size:.1f}% of raw frames, "
+            f"{num_frames * args.iterations / elapsed:.0f} frames/s decoded on host"
+        )
+
+
+def cmd_example(args):
+    frames = []
+    for n in range(args.frames):
+        leds = []
+        for i in range(LED_NUM):
+            # Rainbow chasing down the EF bar, slowly pulsing dragon
+            if i < 6:
+                value = 0.5 + 0.5 * abs((n % 64) - 32) / 32
+                r, g, b = colorsys.hsv_to_rgb(0.33, 1.0, value * 0.5)
+            else:
+                r, g, b = colorsys.hsv_to_rgb(((i - 6) / 11 + n / args.frames) % 1.0, 1.0, 1.0)
+            leds.append("#%02x%02x%02x" % (int(r * 255), int(g * 255), int(b * 255)))
+        frames.append({"duration": 40, "leds": leds})
+    with open(args.output, "w") as f:
+        json.dump({"name": "example", "loop": True, "loop_start": 0, "frames": frames}, f, indent=2)
+    print(f"{args.output}: {len(frames)} frames")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="EF badge LED animation tool")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("encode", help="Encode a JSON animation into the binary format")
+    p.add_argument("input")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("-k", "--keyframe-interval", type=int, default=0,
+                   help="Force a keyframe every N frames (default: only when smaller than a delta)")
+    p.set_defaults(func=cmd_encode)
+
+    p = sub.add_parser("decode", help="Decode a binary animation or partition image into JSON")
+    p.add_argument("input")
+    p.add_argument("-o", "--output")
+    p.set_defaults(func=cmd_decode)
+
+    p = sub.add_parser("validate", help="Validate a binary animation or partition image")
+    p.add_argument("input")
+    p.set_defaults(func=cmd_validate)
+
+    p = sub.add_parser("pack", help="Pack binary animations into a partition image")
+    p.add_argument("inputs", nargs="+")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--partition-size", default=hex(PARTITION_SIZE_DEFAULT))
+    p.set_defaults(func=cmd_pack)
+
+    p = sub.add_parser("bench", help="Report size and decoding speed of animations")
+    p.add_argument("input")
+    p.add_argument("-n", "--iterations", type=int, default=100)
+    p.set_defaults(func=cmd_bench)
+
+    p = sub.add_parser("example", help="Generate an example JSON animation")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--frames", type=int, default=110)
+    p.set_defaults(func=cmd_example)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args) or 0
+    except FormatError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,259 @@
+#!/usr/bin/python3
+
+# MIT License
+#
+# Copyright 2024 Eurofurence e.V.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the “Software”),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+
+"""
+Retrieves and analyzes the LED frame capture of badges running a firmware
+built with EFLED_ENABLE_CAPTURE (PlatformIO environment "debug").
+The binary format is documented in lib/EFLed/EFLedCapture.h.
+
+Example usage:
+
+    ./efcapture.py dump --port /dev/ttyACM0 -o capture.bin
+    ./efcapture.py analyze capture.bin
+    ./efcapture.py timeline capture.bin
+
+Requires pyserial for the dump command.
+"""
+
+import argparse
+import statistics
+import struct
+import sys
+import time
+
+MAGIC = b"EFCP"
+VERSION = 1
+HEADER = struct.Struct("<4sBBHI")
+ENTRY = struct.Struct("<IHBB")
+FOOTER = struct.Struct("<I")
+
+FLAG_SKIPPED = 0x01
+FLAG_GATED = 0x02
+
+CMD_DUMP = b"c"
+
+
+class FormatError(Exception):
+    pass
+
+
+def entry_size(num_leds):
+    return ENTRY.size + 3 * num_leds
+
+
+def parse(data):
+    """Parses a capture dump. Returns the dump timestamp and a list of frames."""
+    start = data.find(MAGIC)
+    if start < 0:
+        raise FormatError("No capture found")
+    if len(data) < start + HEADER.size:
+        raise FormatError("Capture is truncated")
+
+    magic, version, num_leds, count, now_us = HEADER.unpack_from(data, start)
+    if version != VERSION:
+        raise FormatError(f"Unsupported version: {version}")
+
+    end = start + HEADER.size + count * entry_size(num_leds)
+    if len(data) < end + FOOTER.size:
+        raise FormatError("Capture is truncated")
+    (checksum,) = FOOTER.unpack_from(data, end)
+    if checksum != sum(data[start:end]) & 0xFFFFFFFF:
+        raise FormatError("Checksum mismatch")
+
+    frames = []
+    pos = start + HEADER.size
+    for _ in range(count):
+        timestamp_us, seq, brightness, flags = ENTRY.unpack_from(data, pos)
+        pos += ENTRY.size
+        leds = [tuple(data[pos + i * 3:pos + i * 3 + 3]) for i in range(num_leds)]
+        pos += 3 * num_leds
+        frames.append({
+            "timestamp_us": timestamp_us,
+            "seq": seq,
+            "brightness": brightness,
+            "flags": flags,
+            "leds": leds,
+        })
+
+    # Unwrap 32-bit timestamps relative to the first frame
+    offset = 0
+    for i, frame in enumerate(frames):
+        if i > 0 and frame["timestamp_us"] + offset < frames[i - 1]["time_us"]:
+            offset += 1 << 32
+        frame["time_us"] = frame["timestamp_us"] + offset
+
+    return now_us, frames
+
+
+def dump(port, timeout):
+    """Requests a capture dump from a badge"""
+    import serial
+
+    with serial.Serial(port, 115200, timeout=0.1) as ser:
+        ser.reset_input_buffer()
+        ser.write(CMD_DUMP)
+        data = bytearray()
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            data += ser.read(4096)
+            start = data.find(MAGIC)
+            if start < 0 or len(data) < start + HEADER.size:
+                continue
+            _, _, num_leds, count, _ = HEADER.unpack_from(data, start)
+            end = start + HEADER.size + count * entry_size(num_leds) + FOOTER.size
+            if len(data) >= end:
+                return bytes(data[start:end])
+        raise FormatError("Timeout while waiting for capture")
+
+
+def analyze(frames, interval_ms):
+    """Reconstructs frame timing and detects dropped and duplicate frames"""
+    sent = [f for f in frames if not f["flags"] & (FLAG_SKIPPED | FLAG_GATED)]
+    intervals = [(b["time_us"] - a["time_us"]) / 1000.0 for a, b in zip(frames, frames[1:])]
+    report = {
+        "frames": len(frames),
+        "sent": len(sent),
+        "skipped": sum(1 for f in frames if f["flags"] & FLAG_SKIPPED),
+        "gated": sum(1 for f in frames if f["flags"] & FLAG_GATED),
+        "dropped": [],
+        "duplicates": [],
+        "seq_gaps": [],
+    }
+    if not intervals:
+        return report
+
+    expected = interval_ms or statistics.median(intervals)
+    report.update({
+        "duration_ms": (frames[-1]["time_us"] - frames[0]["time_us"]) / 1000.0,
+        "expected_ms": expected,
+        "min_ms": min(intervals),
+        "max_ms": max(intervals),
+        "mean_ms": statistics.mean(intervals),
+        "jitter_ms": statistics.pstdev(intervals),
+    })
+
+    for i, (a, b) in enumerate(zip(frames, frames[1:])):
+        # Frames that arrived much later than expected indicate dropped frames
+        delta = (b["time_us"] - a["time_us"]) / 1000.0
+        if expected > 0 and delta > 1.5 * expected:
+            report["dropped"].append((i + 1, delta, round(delta / expected) - 1))
+        # Presented frames must be numbered consecutively
+        if (b["seq"] - a["seq"]) & 0xFFFF != 1:
+            report["seq_gaps"].append((i + 1, a["seq"], b["seq"]))
+
+    # Transmitting the same frame twice should be prevented by the skip logic
+    for a, b in zip(sent, sent[1:]):
+        if a["leds"] == b["leds"] and a["brightness"] == b["brightness"]:
+            report["duplicates"].append(frames.index(b))
+
+    return report
+
+
+def cmd_dump(args):
+    data = dump(args.port, args.timeout)
+    _, frames = parse(data)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print(f"{args.output}: {len(frames)} frames")
+
+
+def cmd_analyze(args):
+    with open(args.input, "rb") as f:
+        _, frames = parse(f.read())
+    report = analyze(frames, args.interval_ms)
+
+    print(f"Frames:     {report['frames']} ({report['sent']} sent, {report['skipped']} skipped, {report['gated']} gated)")
+    if "duration_ms" in report:
+        print(f"Duration:   {report['duration_ms']:.1f} ms")
+        print(
+            f"Interval:   expected {report['expected_ms']:.2f} ms, min {report['min_ms']:.2f} ms, "
+            f"max {report['max_ms']:.2f} ms, mean {report['mean_ms']:.2f} ms, jitter {report['jitter_ms']:.2f} ms"
+        )
+    print(f"Dropped:    {sum(n for _, _, n in report['dropped'])} frames in {len(report['dropped'])} gaps")
+    for idx, delta, num in report["dropped"]:
+        print(f"  #{idx}: {delta:.2f} ms since last frame, ~{num} frames missing")
+    print(f"Duplicates: {len(report['duplicates'])}")
+    for idx in report["duplicates"]:
+        print(f"  #{idx}: identical to the previously transmitted frame")
+    if report["seq_gaps"]:
+        print(f"Sequence:   {len(report['seq_gaps'])} gaps")
+        for idx, a, b in report["seq_gaps"]:
+            print(f"  #{idx}: {a} -> {b}")
+
+    return 1 if report["dropped"] or report["duplicates"] or report["seq_gaps"] else 0
+
+
+def cmd_timeline(args):
+    with open(args.input, "rb") as f:
+        _, frames = parse(f.read())
+    if not frames:
+        return 0
+
+    start = frames[0]["time_us"]
+    previous = start
+    for idx, frame in enumerate(frames):
+        flags = ("S" if frame["flags"] & FLAG_SKIPPED else "-") + ("G" if frame["flags"] & FLAG_GATED else "-")
+        if args.plain:
+            pixels = " ".join("%02x%02x%02x" % c for c in frame["leds"])
+        else:
+            pixels = "".join("\x1b[48;2;%d;%d;%dm  " % c for c in frame["leds"]) + "\x1b[0m"
+        print(
+            f"{idx:4d} {(frame['time_us'] - start) / 1000.0:10.2f} ms "
+            f"{(frame['time_us'] - previous) / 1000.0:+8.2f} ms  #{frame['seq']:5d} "
+            f"b={frame['brightness']:3d} {flags} {pixels}"
+        )
+        previous = frame["time_us"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="EF badge LED frame capture tool")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("dump", help="Retrieve the capture buffer of a badge via serial")
+    p.add_argument("--port", required=True)
+    p.add_argument("-o", "--output", default="capture.bin")
+    p.add_argument("--timeout", type=float, default=5.0)
+    p.set_defaults(func=cmd_dump)
+
+    p = sub.add_parser("analyze", help="Report frame timing, dropped and duplicate frames")
+    p.add_argument("input")
+    p.add_argument("--interval-ms", type=float, default=0,
+                   help="Expected frame interval (default: median of all intervals)")
+    p.set_defaults(func=cmd_analyze)
+
+    p = sub.add_parser("timeline", help="Render all captured frames")
+    p.add_argument("input")
+    p.add_argument("--plain", action="store_true", help="Print hex colors instead of ANSI color blocks")
+    p.set_defaults(func=cmd_timeline)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args) or 0
+    except FormatError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
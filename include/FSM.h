@@ -34,6 +34,15 @@
 #include "FSMGlobals.h"
 #include "FSMState.h"
 
+/**
+ * @brief Default interval of the render clock in milliseconds
+ */
+#define FSM_RENDER_INTERVAL_MS_DEFAULT 10
+
+/**
+ * @brief Default duration of the LED cross-fade between two states in milliseconds
+ */
+#define FSM_TRANSITION_FADE_MS_DEFAULT 300
 
 /**
  * @brief Main finite state machine (FSM)
@@ -45,6 +54,12 @@ class FSM {
         unsigned int tickrate_ms;         //!< Amount of milliseconds this FSM whishes to be handle()'ed
         unsigned int state_last_run;      //!< Timestamp of the last execution of the current states run() method
 
+        unsigned int render_interval_ms;  //!< Milliseconds between two render() calls of the current state
+        unsigned long render_next;        //!< Timestamp the next frame is due at
+        uint32_t render_frames;           //!< Number of rendered frames
+        uint32_t render_missed;           //!< Number of render deadlines that passed without rendering a frame
+        unsigned int transition_fade_ms;  //!< Duration of the LED cross-fade between two states
+
         std::unique_ptr<FSMState> state;     //!< Current FSM state
         std::queue<FSMEvent> eventqueue;     //!< Queue to store FSMEvents. ATTENTION: THIS IS NOT THREAD SAFE ON ITS OWN!
         std::shared_ptr<FSMGlobals> globals; //!< Global FSM state data
@@ -116,6 +131,58 @@ class FSM {
          */
         void handle(unsigned int num_events);
 
+        /**
+         * @brief Executes the render clock. If the next frame is due, the current
+         * states render() method is called with the current time and the progress
+         * between its last and next logic tick. Must be called as often as possible.
+         */
+        void render();
+
+        /**
+         * @brief Sets the interval of the render clock
+         *
+         * @param interval_ms Milliseconds between two rendered frames
+         */
+        void setRenderIntervalMs(unsigned int interval_ms);
+
+        /**
+         * @brief Retrieves the interval of the render clock
+         *
+         * @return Milliseconds between two rendered frames
+         */
+        unsigned int getRenderIntervalMs();
+
+        /**
+         * @brief Retrieves the number of frames rendered since boot
+         *
+         * @return Number of rendered frames
+         */
+        uint32_t getRenderFrames();
+
+        /**
+         * @brief Retrieves the number of render deadlines that were missed, e.g.
+         * because the main loop was blocked by other work
+         *
+         * @return Number of missed frames since boot
+         */
+        uint32_t getRenderMissedDeadlines();
+
+        /**
+         * @brief Sets the duration of the LED cross-fade on state transitions. The
+         * last frame of the previous state is faded out against the frames of
+         * the next state.
+         *
+         * @param fade_ms Duration of the cross-fade in milliseconds, 0 to disable
+         */
+        void setTransitionFadeMs(unsigned int fade_ms);
+
+        /**
+         * @brief Retrieves the duration of the LED cross-fade on state transitions
+         *
+         * @return Duration of the cross-fade in milliseconds
+         */
+        unsigned int getTransitionFadeMs();
+
         /**
          * @brief Presists the current globals state of this FSM to the NVS partition
          */
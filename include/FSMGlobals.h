@@ -47,7 +47,11 @@ typedef struct {
     uint8_t animSnakeHueIdx = 0;       //!< AnimateSnake: Mode selector
     uint8_t animHeartbeatHue = 0;   //!< AnimateHeartbeat: Hue selector
     uint8_t animHeartbeatSpeed = 1; //!< AnimateHeartbeat: Speed selector
+    uint8_t animHeartbeatModeIdx = 0; //!< AnimateHeartbeat: Mode selector
     uint8_t animMatrixIdx = 0;      //!< AnimateMatrix: Color selector
+    uint8_t animMatrixDensity = 1;  //!< AnimateMatrix: Drop density selector
+    uint8_t animMatrixSpeed = 1;    //!< AnimateMatrix: Drop speed selector
+    uint8_t animPlayerIdx = 0;      //!< AnimatePlayer: Animation selector
 	
 	uint8_t huemeshOwnHue = 0;	//!< GameHuemesh: Own hue smelector
 
@@ -29,6 +29,8 @@
 
 #include <memory>
 
+#include <EFLedAnimation.h>
+
 #include "FSMGlobals.h"
 
 
@@ -117,6 +119,19 @@ class FSMState {
          */
         virtual void run();
 
+        /**
+         * @brief Executed by the FSM render clock at a fixed rate, independent of
+         * the states tick rate. States that render their LEDs here should only
+         * advance their logic state in run() and interpolate towards the next
+         * logic state using progress, so animations stay smooth even if a tick
+         * is late.
+         *
+         * @param t_ms Current timestamp in milliseconds
+         * @param progress Time passed since the last run() relative to the
+         * states tick rate (0: run() just happened, 255: next run() is due)
+         */
+        virtual void render(const unsigned long t_ms, const uint8_t progress);
+
         /**
          * @brief Executd on state exit
          */
@@ -206,21 +221,23 @@ struct AnimateRainbow : public FSMState {
 
     virtual void entry() override;
     virtual void run() override;
+    virtual void render(const unsigned long t_ms, const uint8_t progress) override;
 
     virtual std::unique_ptr<FSMState> touchEventFingerprintLongpress() override;
     virtual std::unique_ptr<FSMState> touchEventFingerprintShortpress() override;
     virtual std::unique_ptr<FSMState> touchEventFingerprintRelease() override;
     virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
 
-    void _animateRainbow();
-    void _animateRainbowCircle();
+    void _animateRainbow(const uint8_t progress);
+    void _animateRainbowCircle(const uint8_t progress);
+    void _animateRainbowSpatial(const uint8_t progress);
 };
 
 /**
  * @brief Displays matrix animation
  */
 struct AnimateMatrix : public FSMState {
-    uint32_t tick = 0;
+    uint8_t hue = 0;
 
     virtual const char* getName() override;
     virtual bool shouldBeRemembered() override;
@@ -232,7 +249,12 @@ struct AnimateMatrix : public FSMState {
     virtual std::unique_ptr<FSMState> touchEventFingerprintLongpress() override;
     virtual std::unique_ptr<FSMState> touchEventFingerprintShortpress() override;
     virtual std::unique_ptr<FSMState> touchEventFingerprintRelease() override;
+    virtual std::unique_ptr<FSMState> touchEventNoseShortpress() override;
+    virtual std::unique_ptr<FSMState> touchEventNoseLongpress() override;
     virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
+
+    void _applyHue();
+    void _showSetting(const uint8_t level);
 };
 
 /**
@@ -253,29 +275,32 @@ struct AnimateSnake : public FSMState {
     virtual std::unique_ptr<FSMState> touchEventFingerprintRelease() override;
     virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
 
+    void _applyMode();
+    void _setupSnake();
+    void _setupMultiSnake();
+
     void _animateSnake();
     void _animateKnightRider();
-
     void _animatePulse();
-
     void _animateRandom();
 };
 
 /**
- * @brief Displays pulsing color
+ * @brief Displays color pulses, spreading from one or more origins across the badge
  */
 struct AnimateHeartbeat : public FSMState {
-    uint32_t tick = 0;
+    uint32_t phase = 0;                //!< Position within the current beat. One beat is 2^32.
+    unsigned long last_render_ms = 0;  //!< Time of the last rendered frame
 
     virtual const char* getName() override;
     virtual bool shouldBeRemembered() override;
-    virtual const unsigned int getTickRateMs() override;
 
     virtual void entry() override;
-    virtual void run() override;
+    virtual void render(const unsigned long t_ms, const uint8_t progress) override;
 
     virtual std::unique_ptr<FSMState> touchEventFingerprintLongpress() override;
     virtual std::unique_ptr<FSMState> touchEventFingerprintShortpress() override;
+    virtual std::unique_ptr<FSMState> touchEventFingerprintRelease() override;
     virtual std::unique_ptr<FSMState> touchEventNoseRelease() override;
     virtual std::unique_ptr<FSMState> touchEventNoseShortpress() override;
     virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
@@ -336,6 +361,29 @@ struct VUMeter : public FSMState {
     virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
 };
 
+/**
+ * @brief Plays LED animations from the animation data partition
+ */
+struct AnimatePlayer : public FSMState {
+    EFLedAnimation animation;
+    unsigned long next_frame_ms = 0;
+
+    virtual const char* getName() override;
+    virtual bool shouldBeRemembered() override;
+    virtual const unsigned int getTickRateMs() override;
+
+    virtual void entry() override;
+    virtual void run() override;
+    virtual void exit() override;
+
+    virtual std::unique_ptr<FSMState> touchEventFingerprintLongpress() override;
+    virtual std::unique_ptr<FSMState> touchEventFingerprintShortpress() override;
+    virtual std::unique_ptr<FSMState> touchEventFingerprintRelease() override;
+    virtual std::unique_ptr<FSMState> touchEventAllLongpress() override;
+
+    void _open();
+};
+
 /**
  * @brief Menu entry point
  */
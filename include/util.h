@@ -32,6 +32,5 @@
 
 const char* toString(EFBoardPowerState state);
 const char* toString(EFTouchZone zone);
-const float wave_function(float x, float start, float end, float amplitude);
 
 #endif /* UTIL_H_ */
\ No newline at end of file
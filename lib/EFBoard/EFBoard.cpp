@@ -29,6 +29,7 @@
 #include <WiFi.h>
 
 #include <EFLed.h>
+#include <EFLedBar.h>
 #include <EFLogging.h>
 
 #include "EFBoard.h"
@@ -280,46 +281,58 @@ void EFBoardClass::enableOTA(const char *password) {
                 // Reset progress
                 ota_last_progress = -1;
 
-                // Setup LEDs
-                EFLed.clear();
+                // Setup LEDs. Status is shown on an overlay above the current state.
+                EFLed.beginFrame();
+                EFLed.fillOverlay(EFLED_OVERLAY_STATUS, CRGB::Black);
                 EFLed.setBrightnessPercent(50);
-                EFLed.setDragonEye(CRGB::Blue);
+                EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_EYE_IDX, CRGB::Blue);
+                EFLed.commitFrame();
             })
             .onEnd([]() {
                 LOG_INFO("(OTA) Finished! Rebooting ...");
+                EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_STATUS);
+                timeline.reset(EFLED_MASK_ALL, CRGB::Black, 255);
                 for (uint8_t i = 0; i < 3; i++) {
-                    EFLed.setDragonEye(CRGB::Green);
-                    delay(500);
-                    EFLed.setDragonEye(CRGB::Black);
-                    delay(500);
+                    timeline.add(500, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::Green);
+                    timeline.add(500, EFLED_MASK_NONE, CRGB::Black);
                 }
-                EFLed.clear();
+                EFLed.playTimeline(EFLED_OVERLAY_STATUS);
+
+                // The main loop is not running anymore, since the badge reboots right after
+                while (EFLed.isTimelineRunning(EFLED_OVERLAY_STATUS)) {
+                    EFLed.update();
+                    delay(EFLED_TIMELINE_INTERVAL_MS);
+                }
+                EFLed.fillOverlay(EFLED_OVERLAY_STATUS, CRGB::Black);
+                EFLed.flush();
             })
             .onProgress([](unsigned int progress, unsigned int total) {
                 uint8_t progresspercent = (progress / (total / 100));
                 if (ota_last_progress < progresspercent) {
                     ota_last_progress = progresspercent;
-                    EFLed.fillEFBarProportionally(progresspercent, CRGB::Red, CRGB::Black);
+                    CRGB bar[EFLED_EFBAR_NUM];
+                    EFLedBar::fill(bar, EFLedBar::level(progress, total), CRGB::Red, CRGB::Black);
+                    EFLed.setOverlayEFBar(EFLED_OVERLAY_STATUS, bar);
                     LOGF_INFO("(OTA) Progress: %u%%\r\n", progresspercent);
                 }
             })
             .onError([](ota_error_t error) {
                 LOGF_ERROR("(OTA) Error[%u]: ", error);
-                EFLed.setDragonNose(CRGB::Red);
+                EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Red);
                 if (error == OTA_AUTH_ERROR) {
                     LOG_WARNING("(OTA) Auth Failed");
-                    EFLed.setDragonNose(CRGB::Purple);
+                    EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Purple);
                 } else if (error == OTA_BEGIN_ERROR) {
-                    EFLed.setDragonNose(CRGB::Green);
+                    EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Green);
                     LOG_ERROR("(OTA) Begin Failed");
                 } else if (error == OTA_CONNECT_ERROR) {
-                    EFLed.setDragonNose(CRGB::Purple);
+                    EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Purple);
                     LOG_ERROR("(OTA) Connect Failed");
                 } else if (error == OTA_RECEIVE_ERROR) {
-                    EFLed.setDragonNose(CRGB::Blue);
+                    EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Blue);
                     LOG_ERROR("(OTA) Receive Failed");
                 } else if (error == OTA_END_ERROR) {
-                    EFLed.setDragonNose(CRGB::Yellow);
+                    EFLed.setOverlayPixel(EFLED_OVERLAY_STATUS, EFLED_DRAGON_NOSE_IDX, CRGB::Yellow);
                     LOG_ERROR("(OTA) End Failed");
                 }
             });
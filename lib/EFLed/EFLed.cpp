@@ -26,34 +26,68 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include <esp_timer.h>
 
 #include <EFLogging.h>
 
 #include "EFLed.h"
+#include "EFLedBar.h"
+#include "EFLedGeometry.h"
+#include "EFLedKernels.h"
 
-static const EFLedClass::LEDPosition led_positions[] = {
-    {17, 126},  // 0
-    {21, 106},
-    {23, 91},
-    {41, 86},
-    {35, 48},
-    {37, 43},  // 5
-    {61, 15},
-    {61, 27},
-    {61, 41},
-    {61, 54},
-    {61, 67},  // 10
-    {61, 79},
-    {61, 93},
-    {61, 105},
-    {61, 118},
-    {61, 131},  // 15
-    {61, 144}
-};
+static_assert(
+    EFLED_CURRENT_BUDGET_MA_DEFAULT >= EFLED_TOTAL_NUM * EFLED_CURRENT_IDLE_MA
+        + (EFLED_TOTAL_NUM * 3 * EFLED_CURRENT_CHANNEL_MA * EFLED_NOMINAL_BRIGHTNESS + 254) / 255,
+    "Default current budget must not dim white frames at the nominal brightness"
+);
 
 EFLedClass::EFLedClass()
-: max_brightness(0)
-, led_data({0})
+: led_data({0})
+, led_front({0})
+, led_data_src(led_data)
+, led_index_src(led_index)
+, palette_offset(0)
+, indexed(false)
+, timeline_update_ms(0)
+, max_brightness(0)
+, brightness(0)
+, brightness_fixed(false)
+, brightness_percent(100)
+, brightness_preview(EFLED_OVERLAY_NUM)
+, current_budget_ma(EFLED_CURRENT_BUDGET_MA_DEFAULT)
+, frame_current_ma(0)
+, frame_depth(0)
+, frame_dirty(false)
+, front_stale(true)
+, power_enabled(false)
+, frame_dark(false)
+, frame_dark_since_ms(0)
+, power_gate_delay_ms(EFLED_POWER_GATE_DELAY_MS_DEFAULT)
+, led_base({0})
+, crossfade_from({0})
+, led_composited({0})
+, composited_scale(0)
+, crossfade_start_ms(0)
+, crossfade_duration_ms(0)
+, frames_sent(0)
+, frames_skipped(0)
+, frames_limited(0)
+, power_gated(0)
+#ifdef EFLED_ENABLE_CAPTURE
+, capture_head(0)
+, capture_count(0)
+, capture_seq(0)
+#endif
+#ifdef EFLED_ENABLE_STATS
+, stats({0})
+, stats_frame_us(EFLED_STATS_FRAME_US_DEFAULT)
+, stats_cpu_mhz(1)
+, stats_last_show_us(0)
+, stats_window_us(0)
+, stats_window_shows(0)
+#endif
+, output_task(nullptr)
+, output_idle(nullptr)
 {
 }
 
@@ -64,105 +98,631 @@ void EFLedClass::init() {
 void EFLedClass::init(const uint8_t absolute_max_brightness) {
     for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
         this->led_data[i] = CRGB::Black;
+        this->led_front[i] = CRGB::Black;
+        this->led_base[i] = CRGB::Black;
+        this->led_composited[i] = CRGB::Black;
     }
+    this->led_data_src = this->led_data;
+    memset(this->led_index, 0, sizeof(this->led_index));
+    this->led_index_src = this->led_index;
+    this->palette_offset = 0;
+    this->indexed = false;
+    for (uint8_t layer = 0; layer < EFLED_OVERLAY_NUM; layer++) {
+        this->overlays[layer].mode = EFLedBlendMode::Normal;
+        this->timelines[layer].reset(EFLED_MASK_NONE);
+        this->clearOverlay(layer);
+    }
+    memset(this->led_linear, 0, sizeof(this->led_linear));
+    this->dither.reset();
+    this->composited_scale = 0;
+    this->crossfade_duration_ms = 0;
+    this->setGamma(EFLED_GAMMA_DEFAULT);
     LOG_INFO("(EFLed) Initialized internal LED data struct");
 
+    // FastLED only ever reads from the front buffer. The back buffer is rendered
+    // into while the output task is transmitting the front buffer.
     FastLED.clearData();
-    FastLED.addLeds<WS2812B, EFLED_PIN_LED_DATA, GRB>(this->led_data, EFLED_TOTAL_NUM);
+    FastLED.addLeds<WS2812B, EFLED_PIN_LED_DATA, GRB>(this->led_front, EFLED_TOTAL_NUM);
+    FastLED.setDither(DISABLE_DITHER);  // Brightness and dithering are handled by present()
     LOGF_DEBUG("(EFLed) Added new WS2812B: %d LEDs @ PIN %d\r\n", EFLED_TOTAL_NUM, EFLED_PIN_LED_DATA);
 
     this->max_brightness = absolute_max_brightness;
-    FastLED.setBrightness(this->max_brightness);
+    this->brightness = min(this->max_brightness, (uint8_t) EFLED_NOMINAL_BRIGHTNESS);
+    this->brightness_fixed = false;
+    this->brightness_percent = 100;
+    this->brightness_preview = EFLED_OVERLAY_NUM;
+    this->front_stale = true;
+    this->frames_sent = 0;
+    this->frames_skipped = 0;
+    this->frames_limited = 0;
+    this->power_gated = 0;
+    this->frame_dark = false;
+#ifdef EFLED_ENABLE_STATS
+    this->stats_cpu_mhz = ESP.getCpuFreqMHz();
+    this->resetStats();
+#endif
     LOGF_DEBUG("(EFLed) Set max_brightness=%d\r\n", this->max_brightness)
 
-    enablePower();
+    if (this->output_task == nullptr) {
+        this->output_idle = xSemaphoreCreateBinary();
+        xSemaphoreGive(this->output_idle);
+        xTaskCreatePinnedToCore(
+            _outputTask,
+            "EFLedOutput",
+            EFLED_OUTPUT_TASK_STACK_SIZE,
+            this,
+            EFLED_OUTPUT_TASK_PRIORITY,
+            &this->output_task,
+            ARDUINO_RUNNING_CORE
+        );
+        LOG_INFO("(EFLed) Started LED output task");
+    }
+
+    this->enablePower();
+}
+
+void EFLedClass::_outputTask(void* arg) {
+    EFLedClass* self = static_cast<EFLedClass*>(arg);
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#ifdef EFLED_ENABLE_STATS
+        const int64_t start_us = esp_timer_get_time();
+        const uint32_t start_cycles = ESP.getCycleCount();
+        FastLED.show(255);
+        self->_recordShow(ESP.getCycleCount() - start_cycles, start_us);
+#else
+        FastLED.show(255);
+#endif
+        xSemaphoreGive(self->output_idle);
+    }
+}
+
+void EFLedClass::setGamma(const float gamma) {
+    for (uint16_t i = 0; i < 256; i++) {
+        this->gamma_lut[i] = (uint16_t) roundf(powf(i / 255.0f, gamma) * 65535.0f);
+    }
+    LOGF_DEBUG("(EFLed) Set gamma=%.2f\r\n", gamma);
 }
 
 void EFLedClass::enablePower() {
-    pinMode(EFLED_PIN_5VBOOST_ENABLE, OUTPUT);
-    digitalWrite(EFLED_PIN_5VBOOST_ENABLE, HIGH);
+    this->_setPower(true);
     LOG_INFO("(EFLed) Enabled +5V boost converter");
-    delay(1);
 }
 
 void EFLedClass::disablePower() {
-    digitalWrite(EFLED_PIN_5VBOOST_ENABLE, LOW);
+    this->_setPower(false);
     LOG_INFO("(EFLed) Disabled +5V boost converter");
     delay(10);
 }
 
+void EFLedClass::_setPower(const bool enabled) {
+    if (enabled) {
+        pinMode(EFLED_PIN_5VBOOST_ENABLE, OUTPUT);
+        digitalWrite(EFLED_PIN_5VBOOST_ENABLE, HIGH);
+        delay(EFLED_POWER_SETTLE_MS);
+    } else {
+        this->flush();
+        digitalWrite(EFLED_PIN_5VBOOST_ENABLE, LOW);
+    }
+    this->power_enabled = enabled;
+    this->front_stale = true;
+}
+
+bool EFLedClass::isPowerEnabled() const {
+    return this->power_enabled;
+}
+
+void EFLedClass::setPowerGateDelayMs(const uint16_t delay_ms) {
+    this->power_gate_delay_ms = delay_ms;
+    LOGF_DEBUG("(EFLed) Set power_gate_delay_ms=%d\r\n", this->power_gate_delay_ms);
+}
+
+uint32_t EFLedClass::getPowerGatedCount() const {
+    return this->power_gated;
+}
+
+void EFLedClass::show() {
+    this->frame_dirty = true;
+    if (this->frame_depth == 0) {
+        this->present();
+    }
+}
+
+void EFLedClass::present() {
+    if (this->output_task == nullptr) {
+        return;
+    }
+
+    this->frame_dirty = false;
+
+    // Composite overlays and expand frame into linear 16-bit space
+    alignas(4) CRGB out[EFLED_TOTAL_NUM];
+    this->_composite(out);
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            this->led_linear[i][c] = this->gamma_lut[out[i].raw[c]];
+        }
+    }
+
+    // Skip re-sending a frame the LEDs already latched. Compare before dithering,
+    // since dithering alters the 8-bit output of identical frames. Static frames
+    // are sent until dithering has settled.
+    const uint16_t scale = this->_limitBrightness();
+    const bool unchanged = (
+        !this->front_stale &&
+        scale == this->composited_scale &&
+        memcmp(this->led_composited, out, sizeof(out)) == 0
+    );
+    if (unchanged && !this->dither.isPending()) {
+        this->frames_skipped++;
+#ifdef EFLED_ENABLE_CAPTURE
+        this->_capture(this->led_front, scale, EFLED_CAPTURE_FLAG_SKIPPED);
+#endif
+        return;
+    }
+    memcpy(this->led_composited, out, sizeof(out));
+    this->composited_scale = scale;
+
+    // Apply brightness and quantize back to 8 bit
+    this->dither.apply(this->led_linear, scale, unchanged, out);
+
+    // Track how long the LEDs have been dark for automatic power gating
+    bool dark = true;
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM && dark; i++) {
+        dark = !out[i];
+    }
+    if (dark && !this->frame_dark) {
+        this->frame_dark_since_ms = millis();
+    }
+    this->frame_dark = dark;
+
+    // Unpowered LEDs are dark anyways. Restore power before anything else is shown.
+    if (!this->power_enabled) {
+        if (dark) {
+            this->frames_skipped++;
+#ifdef EFLED_ENABLE_CAPTURE
+            this->_capture(out, scale, EFLED_CAPTURE_FLAG_GATED);
+#endif
+            return;
+        }
+        this->_setPower(true);
+    }
+
+    // Dithering can still yield the frame the LEDs already latched. Comparing against
+    // the front buffer is safe while transmitting, since the output task only reads it.
+    if (!this->front_stale && memcmp(this->led_front, out, sizeof(out)) == 0) {
+        this->frames_skipped++;
+#ifdef EFLED_ENABLE_CAPTURE
+        this->_capture(out, scale, EFLED_CAPTURE_FLAG_SKIPPED);
+#endif
+        return;
+    }
+
+#ifdef EFLED_ENABLE_CAPTURE
+    this->_capture(out, scale, 0);
+#endif
+
+    // The front buffer can only be touched after the previous frame is out
+#ifdef EFLED_ENABLE_STATS
+    if (this->isTransmitting()) {
+        this->stats.blocked++;
+    }
+#endif
+    xSemaphoreTake(this->output_idle, portMAX_DELAY);
+    memcpy(this->led_front, out, sizeof(out));
+    this->front_stale = false;
+    this->frames_sent++;
+    xTaskNotifyGive(this->output_task);
+}
+
+#ifdef EFLED_ENABLE_CAPTURE
+void EFLedClass::_capture(const CRGB out[EFLED_TOTAL_NUM], const uint16_t scale, const uint8_t flags) {
+    EFLedCaptureEntry& entry = this->capture[this->capture_head];
+    entry.timestamp_us = micros();
+    entry.seq = this->capture_seq++;
+    entry.brightness = scale >> 8;
+    entry.flags = flags;
+    memcpy(entry.leds, out, sizeof(entry.leds));
+
+    this->capture_head = (this->capture_head + 1) % EFLED_CAPTURE_NUM;
+    if (this->capture_count < EFLED_CAPTURE_NUM) {
+        this->capture_count++;
+    }
+}
+
+void EFLedClass::dumpCapture(Print& out) const {
+    uint32_t checksum = 0;
+    auto write = [&out, &checksum](const void* data, const size_t len) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i++) {
+            checksum += bytes[i];
+        }
+        out.write(bytes, len);
+    };
+
+    const uint8_t version = EFLED_CAPTURE_VERSION;
+    const uint8_t num_leds = EFLED_TOTAL_NUM;
+    const uint16_t count = this->capture_count;
+    const uint32_t now_us = micros();
+    write(EFLED_CAPTURE_MAGIC, 4);
+    write(&version, sizeof(version));
+    write(&num_leds, sizeof(num_leds));
+    write(&count, sizeof(count));
+    write(&now_us, sizeof(now_us));
+
+    // Oldest entry first. Entries are written field by field to avoid padding.
+    uint16_t idx = (this->capture_head + EFLED_CAPTURE_NUM - this->capture_count) % EFLED_CAPTURE_NUM;
+    for (uint16_t n = 0; n < count; n++) {
+        const EFLedCaptureEntry& entry = this->capture[idx];
+        write(&entry.timestamp_us, sizeof(entry.timestamp_us));
+        write(&entry.seq, sizeof(entry.seq));
+        write(&entry.brightness, sizeof(entry.brightness));
+        write(&entry.flags, sizeof(entry.flags));
+        write(entry.leds, sizeof(entry.leds));
+        idx = (idx + 1) % EFLED_CAPTURE_NUM;
+    }
+
+    out.write(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum));
+    out.flush();
+}
+
+void EFLedClass::clearCapture() {
+    this->capture_head = 0;
+    this->capture_count = 0;
+}
+
+uint16_t EFLedClass::getCaptureCount() const {
+    return this->capture_count;
+}
+#endif
+
+#ifdef EFLED_ENABLE_STATS
+/**
+ * @brief Determines the histogram bucket of a duration
+ */
+static uint8_t statsBucket(const uint32_t us) {
+    const uint8_t bucket = us > 0 ? 31 - __builtin_clz(us) : 0;
+    return bucket < EFLED_STATS_HIST_NUM ? bucket : EFLED_STATS_HIST_NUM - 1;
+}
+
+void EFLedClass::_recordShow(const uint32_t cycles, const int64_t start_us) {
+    EFLedStats& s = this->stats;
+    s.shows++;
+    s.show_cycles_last = cycles;
+    s.show_cycles_min = min(s.show_cycles_min, cycles);
+    s.show_cycles_max = max(s.show_cycles_max, cycles);
+    s.show_cycles_total += cycles;
+    s.show_hist[statsBucket(cycles / this->stats_cpu_mhz)]++;
+
+    if (this->stats_last_show_us > 0) {
+        const uint32_t interval = start_us - this->stats_last_show_us;
+        s.interval_us_last = interval;
+        s.interval_hist[statsBucket(interval)]++;
+        s.interval_us_min = min(s.interval_us_min, interval);
+        if (interval < EFLED_STATS_IDLE_US) {
+            s.interval_us_max = max(s.interval_us_max, interval);
+            if (interval > this->stats_frame_us + this->stats_frame_us / 2) {
+                s.late++;
+            }
+        }
+    }
+    this->stats_last_show_us = start_us;
+
+    // Windows can span idle time, so average over the time that actually elapsed
+    const int64_t window_us = start_us - this->stats_window_us;
+    if (window_us >= 1000000) {
+        s.shows_per_second = (uint64_t) (s.shows - this->stats_window_shows) * 1000000 / window_us;
+        this->stats_window_shows = s.shows;
+        this->stats_window_us = start_us;
+    }
+}
+
+EFLedStats EFLedClass::getStats() {
+    this->flush();
+    return this->stats;
+}
+
+void EFLedClass::resetStats() {
+    this->flush();
+    this->stats = {0};
+    this->stats.show_cycles_min = UINT32_MAX;
+    this->stats.interval_us_min = UINT32_MAX;
+    this->stats_last_show_us = 0;
+    this->stats_window_us = esp_timer_get_time();
+    this->stats_window_shows = 0;
+}
+
+void EFLedClass::setFrameIntervalUs(const uint32_t frame_us) {
+    this->stats_frame_us = frame_us;
+    LOGF_DEBUG("(EFLed) Set stats_frame_us=%lu\r\n", (unsigned long) this->stats_frame_us);
+}
+
+void EFLedClass::printStats(Print& out) {
+    const EFLedStats s = this->getStats();
+    const uint32_t mhz = this->stats_cpu_mhz;
+
+    out.printf("EFLed stats: %lu shows, %lu shows/s\r\n", (unsigned long) s.shows, (unsigned long) s.shows_per_second);
+    if (s.shows > 0) {
+        out.printf(
+            "  show:     last %lu us, min %lu us, max %lu us, avg %lu us\r\n",
+            (unsigned long) (s.show_cycles_last / mhz),
+            (unsigned long) (s.show_cycles_min / mhz),
+            (unsigned long) (s.show_cycles_max / mhz),
+            (unsigned long) (s.show_cycles_total / s.shows / mhz)
+        );
+    }
+    if (s.shows > 1) {
+        out.printf(
+            "  interval: last %lu us, min %lu us, max %lu us\r\n",
+            (unsigned long) s.interval_us_last,
+            (unsigned long) s.interval_us_min,
+            (unsigned long) s.interval_us_max
+        );
+    }
+    out.printf(
+        "  late: %lu (> %lu us), blocked: %lu\r\n",
+        (unsigned long) s.late,
+        (unsigned long) (this->stats_frame_us + this->stats_frame_us / 2),
+        (unsigned long) s.blocked
+    );
+    out.printf("  %10s %10s %10s\r\n", ">= us", "show", "interval");
+    for (uint8_t i = 0; i < EFLED_STATS_HIST_NUM; i++) {
+        if (s.show_hist[i] > 0 || s.interval_hist[i] > 0) {
+            out.printf(
+                "  %10lu %10lu %10lu\r\n",
+                i > 0 ? 1UL << i : 0UL,
+                (unsigned long) s.show_hist[i],
+                (unsigned long) s.interval_hist[i]
+            );
+        }
+    }
+}
+#endif
+
+uint32_t EFLedClass::getFramesSent() const {
+    return this->frames_sent;
+}
+
+uint32_t EFLedClass::getFramesSkipped() const {
+    return this->frames_skipped;
+}
+
+uint32_t EFLedClass::getFramesLimited() const {
+    return this->frames_limited;
+}
+
+void EFLedClass::_composite(CRGB out[EFLED_TOTAL_NUM]) {
+    if (this->indexed) {
+        for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+            out[i] = this->palette[(this->led_index_src[i] + this->palette_offset) % EFLED_PALETTE_NUM];
+        }
+    } else {
+        memcpy(out, this->led_data_src, sizeof(this->led_data));
+    }
+
+    if (this->crossfade_duration_ms > 0) {
+        const unsigned long elapsed = millis() - this->crossfade_start_ms;
+        if (elapsed >= this->crossfade_duration_ms) {
+            this->crossfade_duration_ms = 0;
+        } else {
+            const uint8_t amount = elapsed * 255 / this->crossfade_duration_ms;
+            EFLedKernels::blend(this->crossfade_from, out, out, EFLED_TOTAL_NUM, amount);
+        }
+    }
+    memcpy(this->led_base, out, sizeof(this->led_base));
+
+    for (const EFLedLayer& layer : this->overlays) {
+        if (!layer.active) {
+            continue;
+        }
+
+        switch (layer.mode) {
+            case EFLedBlendMode::Normal:
+                EFLedKernels::blendAlpha(out, layer.color, layer.alpha, EFLED_TOTAL_NUM);
+                break;
+            case EFLedBlendMode::Add:
+                EFLedKernels::addAlpha(out, layer.color, layer.alpha, EFLED_TOTAL_NUM);
+                break;
+            case EFLedBlendMode::Multiply:
+                EFLedKernels::multiplyAlpha(out, layer.color, layer.alpha, EFLED_TOTAL_NUM);
+                break;
+        }
+    }
+}
+
+uint16_t EFLedClass::_limitBrightness() {
+    constexpr uint32_t idle_ma = EFLED_TOTAL_NUM * EFLED_CURRENT_IDLE_MA;
+    constexpr uint64_t full_scale = 65535ULL * 65535ULL;
+    const uint16_t scale = this->brightness * 257;
+
+    // Sparse frames may be boosted by the same factor the maximum brightness exceeds the nominal one
+    const uint8_t nominal = min(this->max_brightness, (uint8_t) EFLED_NOMINAL_BRIGHTNESS);
+    const uint16_t ceiling = this->brightness_fixed || nominal == 0
+        ? scale
+        : min((uint32_t) this->brightness * this->max_brightness / nominal, (uint32_t) 255) * 257;
+
+    // Current scales linearly with the sum of all channel duty cycles
+    const uint32_t channel_sum = EFLedKernels::sum16(&this->led_linear[0][0], EFLED_TOTAL_NUM * 3);
+    const uint64_t dynamic = (uint64_t) channel_sum * EFLED_CURRENT_CHANNEL_MA * ceiling;
+
+    // Dynamic current budget, scaled by full_scale to stay in integer arithmetic. Boosted
+    // frames never draw more than all LEDs lit in white at the set brightness.
+    constexpr uint32_t channels_full = EFLED_TOTAL_NUM * 3 * 65535;
+    const uint64_t lit = (uint64_t) channels_full * EFLED_CURRENT_CHANNEL_MA * scale;
+    const uint64_t budget = min(
+        this->current_budget_ma > idle_ma ? (this->current_budget_ma - idle_ma) * full_scale : 0,
+        ceiling > scale ? lit : UINT64_MAX
+    );
+
+    if (dynamic <= budget) {
+        this->frame_current_ma = idle_ma + dynamic / full_scale;
+        return ceiling;
+    }
+
+    // Dim frame just enough to fit into the budget
+    const uint16_t limited = ceiling * budget / dynamic;
+    this->frame_current_ma = idle_ma + (uint64_t) channel_sum * EFLED_CURRENT_CHANNEL_MA * limited / full_scale;
+    if (limited < scale) {
+        this->frames_limited++;
+    }
+    return limited;
+}
+
+void EFLedClass::setCurrentBudgetMA(const uint16_t budget_ma) {
+    this->current_budget_ma = budget_ma;
+    LOGF_DEBUG("(EFLed) Set current_budget_ma=%d\r\n", this->current_budget_ma);
+    this->show();
+}
+
+uint16_t EFLedClass::getCurrentBudgetMA() const {
+    return this->current_budget_ma;
+}
+
+uint16_t EFLedClass::getFrameCurrentMA() const {
+    return this->frame_current_ma;
+}
+
+bool EFLedClass::isTransmitting() const {
+    return this->output_idle != nullptr && uxSemaphoreGetCount(this->output_idle) == 0;
+}
+
+void EFLedClass::flush() {
+    if (this->output_idle == nullptr) {
+        return;
+    }
+
+    xSemaphoreTake(this->output_idle, portMAX_DELAY);
+    xSemaphoreGive(this->output_idle);
+}
+
+void EFLedClass::beginFrame() {
+    this->frame_depth++;
+}
+
+void EFLedClass::commitFrame() {
+    if (this->frame_depth == 0) {
+        LOG_WARNING("(EFLed) commitFrame() called without open frame");
+        return;
+    }
+
+    this->frame_depth--;
+    if (this->frame_depth == 0 && this->frame_dirty) {
+        this->present();
+    }
+}
+
+bool EFLedClass::isFrameOpen() const {
+    return this->frame_depth > 0;
+}
+
+void EFLedClass::startCrossfade(const uint16_t duration_ms) {
+    memcpy(this->crossfade_from, this->led_base, sizeof(this->crossfade_from));
+    this->crossfade_start_ms = millis();
+    this->crossfade_duration_ms = duration_ms;
+}
+
+bool EFLedClass::isCrossfading() const {
+    return this->crossfade_duration_ms > 0;
+}
+
 void EFLedClass::clear() {
     for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
         this->led_data[i] = CRGB::Black;
     }
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setBrightnessPercent(uint8_t brightness) {
-    FastLED.setBrightness(round((min(brightness, (uint8_t) 100) / (float) 100) * this->max_brightness));
-    FastLED.show();
+    this->brightness_percent = min(brightness, (uint8_t) 100);
+    if (this->brightness_preview == EFLED_OVERLAY_NUM) {
+        this->_applyBrightnessPercent(this->brightness_percent);
+    }
 }
 
 uint8_t EFLedClass::getBrightnessPercent() const {
-    return (uint8_t) round(FastLED.getBrightness() / (float) this->max_brightness * 100);
+    return this->brightness_percent;
+}
+
+void EFLedClass::setFixedBrightness(const uint8_t brightness) {
+    this->brightness = min(brightness, this->max_brightness);
+    this->brightness_fixed = true;
+    this->show();
+}
+
+void EFLedClass::_applyBrightnessPercent(const uint8_t percent) {
+    if (this->brightness_fixed) {
+        return;
+    }
+
+    const uint8_t nominal = min(this->max_brightness, (uint8_t) EFLED_NOMINAL_BRIGHTNESS);
+    this->brightness = round((min(percent, (uint8_t) 100) / (float) 100) * nominal);
+    this->show();
+}
+
+void EFLedClass::_endBrightnessPreview(const uint8_t layer) {
+    if (this->brightness_preview == layer) {
+        this->brightness_preview = EFLED_OVERLAY_NUM;
+        this->_applyBrightnessPercent(this->brightness_percent);
+    }
 }
 
 void EFLedClass::setAll(const CRGB color[EFLED_TOTAL_NUM]) {
     for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
         this->led_data[i] = color[i];
     }
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setAllSolid(const CRGB color) {
     for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
         this->led_data[i] = color;
     }
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonNose(const CRGB color) {
     this->led_data[EFLED_DRAGON_NOSE_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonMuzzle(const CRGB color) {
     this->led_data[EFLED_DRAGON_MUZZLE_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonEye(const CRGB color) {
     this->led_data[EFLED_DRAGON_EYE_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonCheek(const CRGB color) {
     this->led_data[EFLED_DRAGON_CHEEK_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonEarBottom(const CRGB color) {
     this->led_data[EFLED_DRAGON_EAR_BOTTOM_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragonEarTop(const CRGB color) {
     this->led_data[EFLED_DRAGON_EAR_TOP_IDX] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setDragon(const CRGB color[EFLED_DRAGON_NUM]) {
     for (uint8_t i = 0; i < EFLED_DRAGON_NUM; i++) {
         this->led_data[EFLED_DARGON_OFFSET + i] = color[i];
     }
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setEFBar(const CRGB color[EFLED_EFBAR_NUM]) {
     for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
         this->led_data[EFLED_EFBAR_OFFSET + i] = color[i];
     }
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setEFBar(uint8_t idx, const CRGB color) {
@@ -171,7 +731,7 @@ void EFLedClass::setEFBar(uint8_t idx, const CRGB color) {
     }
 
     this->led_data[EFLED_EFBAR_OFFSET + idx] = color;
-    FastLED.show();
+    this->show();
 }
 
 void EFLedClass::setEFBarCursor(
@@ -179,17 +739,214 @@ void EFLedClass::setEFBarCursor(
     const CRGB color_on,
     const CRGB color_off
 ) {
-    for (int8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
-        int8_t distance = abs((int16_t)idx - i);
-        uint8_t fade = static_cast<uint8_t>(std::clamp(distance * 64.0f, 0.0f, 255.0f));
-        this->led_data[EFLED_EFBAR_OFFSET + i] = (i == idx) ? color_on : color_off.scale8(fade);
+    this->setEFBarCursorSmooth(idx * EFLEDBAR_SUBSTEPS, color_on, color_off);
+}
+
+void EFLedClass::setEFBarCursorSmooth(
+    uint16_t pos,
+    const CRGB color_on,
+    const CRGB color_off
+) {
+    EFLedBar::cursor(&this->led_data[EFLED_EFBAR_OFFSET], pos, color_on, color_off);
+    this->show();
+}
+
+void EFLedClass::setDataSource(const CRGB* src) {
+    this->led_data_src = src != nullptr ? src : this->led_data;
+    this->show();
+}
+
+void EFLedClass::setIndexedMode(const bool enabled) {
+    if (this->indexed == enabled && (enabled || this->led_index_src == this->led_index)) {
+        return;
+    }
+
+    this->indexed = enabled;
+    if (!enabled) {
+        this->led_index_src = this->led_index;
+    }
+    this->show();
+}
+
+bool EFLedClass::isIndexedMode() const {
+    return this->indexed;
+}
+
+void EFLedClass::setPalette(const CRGBPalette16& palette) {
+    this->palette = palette;
+    this->show();
+}
+
+void EFLedClass::setPaletteEntry(const uint8_t idx, const CRGB color) {
+    if (idx >= EFLED_PALETTE_NUM) {
+        return;
+    }
+
+    this->palette[idx] = color;
+    this->show();
+}
+
+void EFLedClass::setPaletteOffset(const uint8_t offset) {
+    this->palette_offset = offset % EFLED_PALETTE_NUM;
+    this->show();
+}
+
+uint8_t EFLedClass::getPaletteOffset() const {
+    return this->palette_offset;
+}
+
+void EFLedClass::setIndex(const uint8_t idx, const uint8_t index) {
+    if (idx >= EFLED_TOTAL_NUM) {
+        return;
+    }
+
+    this->led_index[idx] = index;
+    this->show();
+}
+
+void EFLedClass::setIndexAll(const uint8_t index[EFLED_TOTAL_NUM]) {
+    memcpy(this->led_index, index, sizeof(this->led_index));
+    this->show();
+}
+
+void EFLedClass::setIndexSource(const uint8_t* src) {
+    this->led_index_src = src != nullptr ? src : this->led_index;
+    this->show();
+}
+
+void EFLedClass::setOverlayPixel(const uint8_t layer, const uint8_t idx, const CRGB color, const uint8_t alpha) {
+    if (layer >= EFLED_OVERLAY_NUM || idx >= EFLED_TOTAL_NUM) {
+        return;
+    }
+
+    this->overlays[layer].color[idx] = color;
+    this->overlays[layer].alpha[idx] = alpha;
+    this->overlays[layer].active |= alpha > 0;
+    this->show();
+}
+
+void EFLedClass::setOverlayEFBar(const uint8_t layer, const CRGB color[EFLED_EFBAR_NUM], const uint8_t alpha) {
+    if (layer >= EFLED_OVERLAY_NUM) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+        this->overlays[layer].color[EFLED_EFBAR_OFFSET + i] = color[i];
+        this->overlays[layer].alpha[EFLED_EFBAR_OFFSET + i] = alpha;
+    }
+    this->overlays[layer].active |= alpha > 0;
+    this->show();
+}
+
+void EFLedClass::fillOverlay(const uint8_t layer, const CRGB color, const uint8_t alpha) {
+    if (layer >= EFLED_OVERLAY_NUM) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        this->overlays[layer].color[i] = color;
+        this->overlays[layer].alpha[i] = alpha;
+    }
+    this->overlays[layer].active = alpha > 0;
+    this->show();
+}
+
+void EFLedClass::clearOverlay(const uint8_t layer) {
+    this->fillOverlay(layer, CRGB::Black, 0);
+}
+
+void EFLedClass::setOverlayBlendMode(const uint8_t layer, const EFLedBlendMode mode) {
+    if (layer >= EFLED_OVERLAY_NUM) {
+        return;
+    }
+
+    this->overlays[layer].mode = mode;
+    this->show();
+}
+
+EFLedTimeline& EFLedClass::getTimeline(const uint8_t layer) {
+    return this->timelines[min(layer, (uint8_t) (EFLED_OVERLAY_NUM - 1))];
+}
+
+void EFLedClass::playTimeline(const uint8_t layer) {
+    if (layer >= EFLED_OVERLAY_NUM) {
+        return;
+    }
+
+    // A restarted timeline must not keep the brightness previewed by its former keyframes
+    this->_endBrightnessPreview(layer);
+    this->timelines[layer].start(millis());
+    this->timeline_update_ms = 0;
+    this->update();
+}
+
+void EFLedClass::stopTimeline(const uint8_t layer) {
+    if (layer >= EFLED_OVERLAY_NUM || !this->timelines[layer].isRunning()) {
+        return;
     }
-    FastLED.show();
+
+    this->timelines[layer].stop();
+    this->clearOverlay(layer);
+    this->_endBrightnessPreview(layer);
+}
+
+bool EFLedClass::isTimelineRunning(const uint8_t layer) const {
+    return layer < EFLED_OVERLAY_NUM && this->timelines[layer].isRunning();
+}
+
+void EFLedClass::update() {
+    const unsigned long now = millis();
+
+    // Gate LED power after being dark for long enough. Never cut power while a
+    // frame is still being clocked out.
+    if (
+        this->power_enabled &&
+        this->power_gate_delay_ms > 0 &&
+        this->frame_dark &&
+        now - this->frame_dark_since_ms >= this->power_gate_delay_ms &&
+        !this->isTransmitting()
+    ) {
+        this->_setPower(false);
+        this->power_gated++;
+        LOG_DEBUG("(EFLed) Gated +5V boost converter");
+    }
+
+    if (this->timeline_update_ms != 0 && now - this->timeline_update_ms < EFLED_TIMELINE_INTERVAL_MS) {
+        return;
+    }
+    this->timeline_update_ms = now;
+
+    this->beginFrame();
+    for (uint8_t layer = 0; layer < EFLED_OVERLAY_NUM; layer++) {
+        EFLedTimeline& timeline = this->timelines[layer];
+        if (!timeline.isRunning()) {
+            continue;
+        }
+
+        uint8_t brightness;
+        if (timeline.render(now, this->overlays[layer], brightness)) {
+            if (brightness != EFLED_KEYFRAME_KEEP_BRIGHTNESS) {
+                this->brightness_preview = layer;
+                this->_applyBrightnessPercent(brightness);
+            }
+            this->show();
+        } else {
+            this->clearOverlay(layer);
+            this->_endBrightnessPreview(layer);
+        }
+    }
+
+    // Keep presenting while a cross-fade is running or a static frame is being
+    // dithered, even if nothing else changed
+    if (this->crossfade_duration_ms > 0 || this->dither.isPending()) {
+        this->show();
+    }
+    this->commitFrame();
 }
 
 EFLedClass::LEDPosition EFLedClass::getLEDPosition(const uint8_t idx) {
-    if (idx < std::size(led_positions)) {
-        return led_positions[idx];
+    if (idx < EFLED_TOTAL_NUM) {
+        return {EFLedGeometry::positions[idx].x, EFLedGeometry::positions[idx].y};
     }
     return {0, 0};  // Returning default position (0, 0) for out-of-bounds
 }
@@ -199,14 +956,26 @@ void EFLedClass::fillEFBarProportionally(
     const CRGB color_on,
     const CRGB color_off
 ) {
-    uint8_t num_leds_on = min(int(round(percent / (100.0f / EFLED_EFBAR_NUM))), EFLED_EFBAR_NUM);
-    for (uint8_t i = 0; i < num_leds_on; i++) {
-        this->led_data[EFLED_EFBAR_OFFSET + i] = color_on;
-    }
-    for (uint8_t i = num_leds_on; i < EFLED_EFBAR_NUM; i++) {
-        this->led_data[EFLED_EFBAR_OFFSET + i] = color_off;
-    }
-    FastLED.show();
+    this->fillEFBar(EFLedBar::level(percent, 100), color_on, color_off);
+}
+
+void EFLedClass::fillEFBar(
+    uint16_t level,
+    const CRGB color_on,
+    const CRGB color_off
+) {
+    EFLedBar::fill(&this->led_data[EFLED_EFBAR_OFFSET], level, color_on, color_off);
+    this->show();
+}
+
+void EFLedClass::fillEFBarGradient(
+    uint16_t level,
+    const CRGB color_first,
+    const CRGB color_last,
+    const CRGB color_off
+) {
+    EFLedBar::fillGradient(&this->led_data[EFLED_EFBAR_OFFSET], level, color_first, color_last, color_off);
+    this->show();
 }
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_EFLED)
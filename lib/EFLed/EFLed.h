@@ -31,6 +31,9 @@
 #define FASTLED_ESP32_SPI_BUS HSPI
 
 #include <FastLED.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
 #define EFLED_PIN_LED_DATA 21
 #define EFLED_PIN_5VBOOST_ENABLE 9
@@ -39,25 +42,77 @@
  * @brief Initial value for global maximum for the LED brightness, 0–255
  * Has a huge impact on battery life.
  *
- * WARNING: The 5V boost converter is unable to power all LEDs on a high brightness level! Max brightness of 255 works
- * only, if only a few LEDs are used at the same time. When using all LEDs even in a single color, values over 60 can
- * overwhelm it and cause the colors to glitch. To be safe, choose a value below 50!
+ * The 5V boost converter is unable to power all LEDs on a high brightness level. Frames that would draw more than
+ * the configured current budget (see EFLED_CURRENT_BUDGET_MA_DEFAULT) are dimmed automatically, so sparse frames can
+ * use a much higher brightness than frames with all LEDs lit.
  */
-#define EFLED_MAX_BRIGHTNESS_DEFAULT 50
+#define EFLED_MAX_BRIGHTNESS_DEFAULT 100
 
-#define EFLED_TOTAL_NUM 17
-#define EFLED_DRAGON_NUM 6
-#define EFLED_EFBAR_NUM 11
+/**
+ * @brief Raw brightness (0-255) a brightness of 100 percent maps to. This was the
+ * static brightness cap before sparse frames could be boosted, so stored brightness
+ * settings keep their output.
+ *
+ * Frames drawing less current than all LEDs lit in white at the set brightness are
+ * boosted, up to the maximum brightness. They never draw more current than such
+ * a fully lit frame.
+ */
+#define EFLED_NOMINAL_BRIGHTNESS 45
 
-#define EFLED_DARGON_OFFSET 0
-#define EFLED_EFBAR_OFFSET 6
+/**
+ * @brief Simple power model of a single WS2812B LED, used to estimate the current
+ * drawn from the 5V boost converter by a frame. Values in milliamps.
+ */
+#define EFLED_CURRENT_IDLE_MA 1      //!< Quiescent current of an LED, even if dark
+#define EFLED_CURRENT_CHANNEL_MA 12  //!< Additional current of a single color channel at full duty cycle
 
-#define EFLED_DRAGON_NOSE_IDX 0
-#define EFLED_DRAGON_MUZZLE_IDX 1
-#define EFLED_DRAGON_EYE_IDX 2
-#define EFLED_DRAGON_CHEEK_IDX 3
-#define EFLED_DRAGON_EAR_BOTTOM_IDX 4
-#define EFLED_DRAGON_EAR_TOP_IDX 5
+/**
+ * @brief Default current budget of the 5V boost converter in milliamps. Matches the
+ * estimate of all LEDs lit in white at EFLED_NOMINAL_BRIGHTNESS (17 mA idle + 108 mA),
+ * the static cap the boost converter was known to handle. Frames that were shown
+ * without glitches before are never dimmed.
+ *
+ * WARNING: Raw brightness values over 45 with all LEDs lit in white overwhelm the boost
+ * converter and cause the colors to glitch. A single color channel is known to work up
+ * to about 100, so keep the maximum brightness at or below that.
+ */
+#define EFLED_CURRENT_BUDGET_MA_DEFAULT 125
+
+/**
+ * @brief Default gamma applied when expanding 8-bit colors into the internal 16-bit
+ * linear framebuffer. A value of 1.0 keeps colors exactly as they were specified.
+ */
+#define EFLED_GAMMA_DEFAULT 1.0f
+
+/**
+ * @brief Default number of milliseconds the presented frame must be completely
+ * dark before the +5V boost converter is switched off automatically. 0 disables
+ * automatic power gating.
+ */
+#define EFLED_POWER_GATE_DELAY_MS_DEFAULT 1000
+
+/**
+ * @brief Milliseconds the boost converter and LEDs need to settle after the +5V
+ * power domain was enabled, before a frame can be latched reliably
+ */
+#define EFLED_POWER_SETTLE_MS 1
+
+/**
+ * @brief Stack size and priority of the task that clocks out frames to the LEDs.
+ * The priority must be above the Arduino loop task so that a presented frame is
+ * picked up immediately.
+ */
+#define EFLED_OUTPUT_TASK_STACK_SIZE 3072
+#define EFLED_OUTPUT_TASK_PRIORITY 2
+
+#define EFLED_PALETTE_NUM 16  //!< Number of colors in the palette used by indexed mode
+
+#include "EFLedCapture.h"
+#include "EFLedDither.h"
+#include "EFLedLayer.h"
+#include "EFLedLayout.h"
+#include "EFLedStats.h"
+#include "EFLedTimeline.h"
 
 
 /**
@@ -67,8 +122,141 @@ class EFLedClass {
 
     protected:
 
-        CRGB led_data[EFLED_TOTAL_NUM];  //!< Internal LED data structure
-        uint8_t max_brightness;  //!< Maximum raw brightness (0-255)
+        CRGB led_data[EFLED_TOTAL_NUM];   //!< Back buffer. All setters render into this buffer.
+        CRGB led_front[EFLED_TOTAL_NUM];  //!< Front buffer. Owned by the output task while transmitting.
+        const CRGB* led_data_src;         //!< Base layer if not in indexed mode. Either led_data or external.
+        alignas(4) uint16_t led_linear[EFLED_TOTAL_NUM][3];  //!< 16-bit linear representation of the back buffer
+        EFLedDither dither;        //!< Quantizes the linear frame to 8 bit
+        uint16_t gamma_lut[256];   //!< Maps 8-bit color values to 16-bit linear intensities
+        uint8_t led_index[EFLED_TOTAL_NUM];       //!< Palette indices of all LEDs, used in indexed mode
+        const uint8_t* led_index_src;             //!< Index buffer expanded in indexed mode. Either led_index or external.
+        CRGBPalette16 palette;     //!< Colors referenced by the index buffer
+        uint8_t palette_offset;    //!< Rotation applied to all indices before the palette lookup
+        bool indexed;              //!< True, if the base layer is expanded from the index buffer instead of led_data
+        EFLedLayer overlays[EFLED_OVERLAY_NUM];   //!< Overlay layers composited above the back buffer
+        EFLedTimeline timelines[EFLED_OVERLAY_NUM];  //!< Effect timelines, each rendering into its overlay layer
+        unsigned long timeline_update_ms;  //!< Timestamp of the last timeline update
+        uint8_t max_brightness;    //!< Maximum raw brightness (0-255)
+        uint8_t brightness;        //!< Current raw brightness (0-255) of fully lit frames. Sparse frames are boosted.
+        bool brightness_fixed;     //!< True, if brightness is fixed by setFixedBrightness()
+        uint8_t brightness_percent;  //!< Brightness in percent set by setBrightnessPercent()
+        uint8_t brightness_preview;  //!< Layer whose timeline overrides brightness_percent, EFLED_OVERLAY_NUM if none
+        uint16_t current_budget_ma;  //!< Maximum current in mA the LEDs are allowed to draw
+        uint16_t frame_current_ma;   //!< Estimated current in mA of the last presented frame
+        uint8_t frame_depth;       //!< Nesting level of currently open frames
+        bool frame_dirty;          //!< True, if LED data changed since the last time the LEDs were updated
+        bool front_stale;          //!< True, if the LEDs might not reflect the front buffer anymore
+        bool power_enabled;        //!< True, if the +5V power domain is currently enabled
+        bool frame_dark;           //!< True, if the last presented frame was completely black
+        unsigned long frame_dark_since_ms;  //!< Timestamp the presented frames turned completely black
+        uint16_t power_gate_delay_ms;       //!< Milliseconds of dark frames after which power is gated, 0 to disable
+        alignas(4) CRGB led_base[EFLED_TOTAL_NUM];        //!< Base layer of the last presented frame, below all overlays
+        alignas(4) CRGB crossfade_from[EFLED_TOTAL_NUM];  //!< Snapshot of the base layer that is faded out
+        alignas(4) CRGB led_composited[EFLED_TOTAL_NUM];  //!< Composited frame of the last transmission, before dithering
+        uint16_t composited_scale;          //!< Brightness scale of the last transmission
+        unsigned long crossfade_start_ms;   //!< Timestamp the current cross-fade started at
+        uint16_t crossfade_duration_ms;     //!< Duration of the current cross-fade, 0 if none is running
+
+        uint32_t frames_sent;     //!< Number of frames that were transmitted to the LEDs
+        uint32_t frames_skipped;  //!< Number of presented frames that were identical to the last one
+        uint32_t frames_limited;  //!< Number of presented frames that were dimmed to stay within the current budget
+        uint32_t power_gated;     //!< Number of times power was gated automatically
+
+#ifdef EFLED_ENABLE_CAPTURE
+        EFLedCaptureEntry capture[EFLED_CAPTURE_NUM];  //!< Ring buffer of the last presented frames
+        uint16_t capture_head;    //!< Index the next frame is captured to
+        uint16_t capture_count;   //!< Number of valid entries in the capture ring buffer
+        uint16_t capture_seq;     //!< Sequence number of the next presented frame
+
+        /**
+         * @brief Records a presented frame in the capture ring buffer
+         *
+         * @param out Frame as it is sent to the LEDs
+         * @param scale Brightness the frame is shown with, as 16-bit scale
+         * @param flags EFLED_CAPTURE_FLAG_*
+         */
+        void _capture(const CRGB out[EFLED_TOTAL_NUM], const uint16_t scale, const uint8_t flags);
+#endif
+
+#ifdef EFLED_ENABLE_STATS
+        EFLedStats stats;             //!< Output timing statistics. Written by the output task.
+        uint32_t stats_frame_us;      //!< Expected interval between two shows
+        uint32_t stats_cpu_mhz;       //!< CPU frequency used to convert cycles to microseconds
+        int64_t stats_last_show_us;   //!< Start of the previous show, 0 if none
+        int64_t stats_window_us;      //!< Start of the current shows per second window
+        uint32_t stats_window_shows;  //!< Number of shows when the current window started
+
+        /**
+         * @brief Records the timing of a single FastLED.show() call. Called by the output task.
+         *
+         * @param cycles CPU cycles the show took
+         * @param start_us Timestamp the show started at
+         */
+        void _recordShow(const uint32_t cycles, const int64_t start_us);
+#endif
+
+        /**
+         * @brief Composites all active overlay layers above the base layer. The base
+         * layer is either the back buffer or, in indexed mode, the expanded index buffer.
+         * While a cross-fade is running, the base layer is blended with the snapshot
+         * taken by startCrossfade(). The resulting base layer is kept in led_base.
+         *
+         * @param out Destination for the composited frame
+         */
+        void _composite(CRGB out[EFLED_TOTAL_NUM]);
+
+        /**
+         * @brief Calculates the brightness the linear frame can be shown with.
+         * Sparse frames are boosted up to max_brightness, but never draw more current
+         * than all LEDs lit in white at the set brightness. No frame exceeds the
+         * current budget. Updates frame_current_ma accordingly.
+         *
+         * @return Brightness as 16-bit scale (0-65535)
+         */
+        uint16_t _limitBrightness();
+
+        /**
+         * @brief Applies a brightness in percent to the presented frames, without
+         * changing brightness_percent
+         *
+         * @param percent Value between 0 (off) and 100 (high)
+         */
+        void _applyBrightnessPercent(const uint8_t percent);
+
+        /**
+         * @brief Ends the brightness preview of a timeline and restores brightness_percent
+         *
+         * @param layer Overlay layer of the timeline that ended
+         */
+        void _endBrightnessPreview(const uint8_t layer);
+
+        /**
+         * @brief Switches the +5V power domain without logging. Enabling waits for
+         * the power domain to settle, disabling waits for a pending transmission.
+         * The LEDs lose their state without power, so the next frame is always
+         * transmitted afterwards.
+         *
+         * @param enabled True to enable, false to disable the power domain
+         */
+        void _setPower(const bool enabled);
+
+        TaskHandle_t output_task;       //!< Task that transmits the front buffer to the LEDs
+        SemaphoreHandle_t output_idle;  //!< Given while the output task is not transmitting
+
+        /**
+         * @brief Marks the LED data as modified. If no frame is currently open, the
+         * frame is presented immediately. Otherwise presenting is deferred until the
+         * outermost frame is committed.
+         */
+        void show();
+
+        /**
+         * @brief Body of the output task. Waits for presented frames and clocks them
+         * out to the LEDs.
+         *
+         * @param arg Pointer to the owning EFLedClass instance
+         */
+        static void _outputTask(void* arg);
 
 
     public:
@@ -102,15 +290,210 @@ class EFLedClass {
          */
         void init(const uint8_t absolute_max_brightness);
 
+        /**
+         * @brief Sets the gamma used to map 8-bit colors to linear LED intensities
+         *
+         * @param gamma Gamma exponent. 1.0 disables gamma correction.
+         */
+        void setGamma(const float gamma);
+
         /**
          * @brief Enables the +5V power domain
          */
-        static void enablePower();
+        void enablePower();
 
         /**
-         * @brief Disabled the +5V power domain
+         * @brief Disabled the +5V power domain. Waits for a pending transmission to
+         * finish first. The next presented frame is always transmitted, since the
+         * LEDs lose their state without power.
          */
-        static void disablePower();
+        void disablePower();
+
+        /**
+         * @brief Determines if the +5V power domain is currently enabled
+         *
+         * @return True, if the LEDs are powered
+         */
+        bool isPowerEnabled() const;
+
+        /**
+         * @brief Sets the time after which the +5V power domain is switched off
+         * automatically while only dark frames are presented. Power is restored
+         * transparently before the next non-dark frame is transmitted.
+         *
+         * @param delay_ms Milliseconds of dark frames before power is gated. 0 disables automatic gating.
+         */
+        void setPowerGateDelayMs(const uint16_t delay_ms);
+
+        /**
+         * @brief Retrieves the number of times power was gated automatically
+         *
+         * @return Number of automatic power-offs since init()
+         */
+        uint32_t getPowerGatedCount() const;
+
+        /**
+         * @brief Presents the current back buffer. The frame is expanded into a 16-bit
+         * linear framebuffer, scaled by the brightness and dithered back to 8 bit. The
+         * result is copied to the front buffer and handed over to the output task, which transmits it to the LEDs
+         * in the background. Rendering the next frame into the back buffer can start
+         * immediately. Only blocks, if the previous frame is still being transmitted.
+         *
+         * If the frame and brightness are identical to the last transmitted frame,
+         * the transmission is skipped entirely once dithering has settled (see
+         * EFLED_DITHER_SETTLE_FRAMES).
+         */
+        void present();
+
+        /**
+         * @brief Retrieves the number of frames that were actually transmitted
+         *
+         * @return Number of transmitted frames since init()
+         */
+        uint32_t getFramesSent() const;
+
+        /**
+         * @brief Retrieves the number of presented frames that were skipped because
+         * they were identical to the frame currently shown by the LEDs
+         *
+         * @return Number of skipped frames since init()
+         */
+        uint32_t getFramesSkipped() const;
+
+        /**
+         * @brief Retrieves the number of frames that were dimmed to stay within
+         * the current budget
+         *
+         * @return Number of dimmed frames since init()
+         */
+        uint32_t getFramesLimited() const;
+
+#ifdef EFLED_ENABLE_STATS
+        /**
+         * @brief Retrieves a snapshot of the LED output timing statistics. Waits
+         * for a pending transmission, so the snapshot is consistent.
+         *
+         * @return Timing statistics since init() or the last resetStats()
+         */
+        EFLedStats getStats();
+
+        /**
+         * @brief Resets all LED output timing statistics
+         */
+        void resetStats();
+
+        /**
+         * @brief Sets the expected interval between two shows. A show counts as
+         * late if it starts more than half of this interval after its expected
+         * time. Frames skipped because nothing changed also lengthen the interval,
+         * so late shows are only meaningful while the LEDs are animated.
+         *
+         * @param frame_us Expected interval in microseconds
+         */
+        void setFrameIntervalUs(const uint32_t frame_us);
+
+        /**
+         * @brief Writes the LED output timing statistics in human-readable form
+         *
+         * @param out Stream to write to, e.g., USBSerial
+         */
+        void printStats(Print& out);
+#endif
+
+#ifdef EFLED_ENABLE_CAPTURE
+        /**
+         * @brief Writes the capture ring buffer in the binary format described in
+         * EFLedCapture.h. Decode it using efcapture.py.
+         *
+         * @param out Stream to write to, e.g., USBSerial
+         */
+        void dumpCapture(Print& out) const;
+
+        /**
+         * @brief Discards all captured frames
+         */
+        void clearCapture();
+
+        /**
+         * @brief Retrieves the number of frames currently held by the capture ring buffer
+         *
+         * @return Number of captured frames
+         */
+        uint16_t getCaptureCount() const;
+#endif
+
+        /**
+         * @brief Sets the maximum current the LEDs are allowed to draw. Frames that
+         * would exceed it are dimmed before being transmitted.
+         *
+         * @param budget_ma Current budget in milliamps
+         */
+        void setCurrentBudgetMA(const uint16_t budget_ma);
+
+        /**
+         * @brief Retrieves the maximum current the LEDs are allowed to draw
+         *
+         * @return Current budget in milliamps
+         */
+        uint16_t getCurrentBudgetMA() const;
+
+        /**
+         * @brief Retrieves the estimated current drawn by the LEDs for the last
+         * presented frame, after dimming it to the current budget
+         *
+         * @return Estimated current in milliamps
+         */
+        uint16_t getFrameCurrentMA() const;
+
+        /**
+         * @brief Determines if a presented frame is still being transmitted
+         *
+         * @return True, if the output task did not yet finish the last frame
+         */
+        bool isTransmitting() const;
+
+        /**
+         * @brief Blocks until the last presented frame was completely transmitted.
+         * Must be called before cutting LED power or entering light sleep.
+         */
+        void flush();
+
+        /**
+         * @brief Opens a new frame. Until the matching commitFrame() is called, all
+         * setters only modify the internal LED data and the LEDs are not updated.
+         * Frames can be nested. Only committing the outermost frame updates the LEDs.
+         */
+        void beginFrame();
+
+        /**
+         * @brief Closes the current frame. If this was the outermost frame and the
+         * LED data was modified since beginFrame(), all LEDs are updated once.
+         */
+        void commitFrame();
+
+        /**
+         * @brief Determines if a frame is currently open
+         *
+         * @return True, if beginFrame() was called more often than commitFrame()
+         */
+        bool isFrameOpen() const;
+
+        /**
+         * @brief Takes a snapshot of the currently shown base layer and fades it
+         * out against all following frames. Overlays are not affected. update()
+         * keeps presenting frames until the cross-fade is finished, even if the
+         * LED data does not change.
+         *
+         * @param duration_ms Duration of the cross-fade. 0 cancels a running cross-fade.
+         */
+        void startCrossfade(const uint16_t duration_ms);
+
+        /**
+         * @brief Determines if a cross-fade is currently running
+         *
+         * @return True, if the snapshot taken by startCrossfade() is still visible
+         */
+        bool isCrossfading() const;
 
         /**
          * @brief Disables all LEDs
@@ -118,12 +501,22 @@ class EFLedClass {
         void clear();
 
         /**
-         * @brief Sets the global brightness for all LEDs in percent, relative to max brightness
+         * @brief Sets the global brightness for all LEDs in percent of EFLED_NOMINAL_BRIGHTNESS.
+         * While a timeline previews a brightness, the new value is applied after it ended.
          *
          * @param brightness Value between 0 (off) and 100 (high)
          */
         void setBrightnessPercent(const uint8_t brightness);
 
+        /**
+         * @brief Fixes the raw brightness of all frames, until init() is called again.
+         * Brightness percent, timelines and sparse frame boosting have no effect
+         * anymore. Meant for emergencies, like a brown out.
+         *
+         * @param brightness Raw brightness (0-255), limited to max brightness
+         */
+        void setFixedBrightness(const uint8_t brightness);
+
         /**
          * @brief Retrieves the current global brightness value
          *
@@ -219,8 +612,19 @@ class EFLedClass {
          */
         void setEFBarCursor(uint8_t idx, const CRGB color_on, const CRGB color_off);
 
+        /**
+         * @brief Same as setEFBarCursor() but the cursor can be placed between
+         * two LEDs, which are then lit proportionally (see EFLedBar::cursor())
+         *
+         * @param pos Cursor position in 1/EFLEDBAR_SUBSTEPS LEDs (from top to bottom)
+         * @param color_on Color to use for the cursor
+         * @param color_off Color to use for inactive LEDs
+         */
+        void setEFBarCursorSmooth(uint16_t pos, const CRGB color_on, const CRGB color_off);
+
         /**
          * @brief Fills the whole EF LED bar according to the given percentage.
+         * The LED at the edge is partially lit.
          *
          * @param percent Value between 0 - 100 indicating the amount of the
          * EF LED bar to be filled (0: none, 50: half, 100: all)
@@ -229,6 +633,193 @@ class EFLedClass {
          */
         void fillEFBarProportionally(uint8_t percent, const CRGB color_on, const CRGB color_off);
 
+        /**
+         * @brief Fills the EF LED bar up to the given level (see EFLedBar::fill())
+         *
+         * @param level Fill level between 0 and EFLEDBAR_LEVEL_MAX. Use
+         * EFLedBar::level() to convert arbitrary ranges.
+         * @param color_on Color to use for active LEDs
+         * @param color_off Color to use for inactive LEDs
+         */
+        void fillEFBar(uint16_t level, const CRGB color_on, const CRGB color_off);
+
+        /**
+         * @brief Fills the EF LED bar up to the given level using a gradient
+         * from color_first (top) to color_last (bottom)
+         *
+         * @param level Fill level between 0 and EFLEDBAR_LEVEL_MAX
+         * @param color_first Color of the top most LED
+         * @param color_last Color of the bottom most LED
+         * @param color_off Color to use for inactive LEDs
+         */
+        void fillEFBarGradient(uint16_t level, const CRGB color_first, const CRGB color_last, const CRGB color_off);
+
+        /**
+         * @brief Shows an external frame instead of the LED data set by the regular
+         * setters, without copying it. The frame must stay valid until it is
+         * detached again. Meant for playing back pre-rendered frames from flash.
+         *
+         * @param src Array of EFLED_TOTAL_NUM colors or nullptr to show the regular LED data again
+         */
+        void setDataSource(const CRGB* src);
+
+        /**
+         * @brief Enables or disables indexed mode. In indexed mode, each LED holds an
+         * index into a palette of EFLED_PALETTE_NUM colors instead of a color. Indices
+         * are expanded to colors only when the frame is presented, so changing a
+         * palette entry or the palette offset recolors all LEDs using it at once.
+         * Disabling indexed mode also detaches an external index buffer.
+         *
+         * @param enabled True to show the index buffer, false to show regular LED data
+         */
+        void setIndexedMode(const bool enabled);
+
+        /**
+         * @brief Determines if indexed mode is enabled
+         *
+         * @return True, if the index buffer is shown instead of regular LED data
+         */
+        bool isIndexedMode() const;
+
+        /**
+         * @brief Replaces the whole palette used in indexed mode
+         *
+         * @param palette Palette to copy
+         */
+        void setPalette(const CRGBPalette16& palette);
+
+        /**
+         * @brief Sets a single palette entry used in indexed mode
+         *
+         * @param idx Number of the palette entry (0 - EFLED_PALETTE_NUM-1)
+         * @param color Color to set
+         */
+        void setPaletteEntry(const uint8_t idx, const CRGB color);
+
+        /**
+         * @brief Sets the rotation added to every index before the palette lookup.
+         * Incrementing it cycles all colors through the palette without touching
+         * the index buffer.
+         *
+         * @param offset Number of palette entries to rotate by
+         */
+        void setPaletteOffset(const uint8_t offset);
+
+        /**
+         * @brief Retrieves the current palette rotation
+         *
+         * @return Number of palette entries indices are rotated by
+         */
+        uint8_t getPaletteOffset() const;
+
+        /**
+         * @brief Sets the palette index of a single LED
+         *
+         * @param idx Number of the LED to set
+         * @param index Palette index to set
+         */
+        void setIndex(const uint8_t idx, const uint8_t index);
+
+        /**
+         * @brief Sets the palette indices of all LEDs
+         *
+         * @param index Array of palette indices for each LED
+         */
+        void setIndexAll(const uint8_t index[EFLED_TOTAL_NUM]);
+
+        /**
+         * @brief Uses an external buffer as index buffer instead of copying it. The
+         * buffer must stay valid until it is detached again.
+         *
+         * @param src Array of EFLED_TOTAL_NUM palette indices or nullptr to use the internal index buffer
+         */
+        void setIndexSource(const uint8_t* src);
+
+        /**
+         * @brief Sets a single pixel of an overlay layer. Overlays are composited
+         * above the regular LED data right before the frame is presented, leaving
+         * the LED data below untouched.
+         *
+         * @param layer Overlay layer to modify (EFLED_OVERLAY_*)
+         * @param idx Number of the LED to set
+         * @param color Color to set
+         * @param alpha Opacity of the pixel (0: transparent, 255: opaque)
+         */
+        void setOverlayPixel(const uint8_t layer, const uint8_t idx, const CRGB color, const uint8_t alpha = 255);
+
+        /**
+         * @brief Sets all EF bar pixels of an overlay layer
+         *
+         * @param layer Overlay layer to modify (EFLED_OVERLAY_*)
+         * @param color Array of colors to set
+         * @param alpha Opacity of all EF bar pixels (0: transparent, 255: opaque)
+         */
+        void setOverlayEFBar(const uint8_t layer, const CRGB color[EFLED_EFBAR_NUM], const uint8_t alpha = 255);
+
+        /**
+         * @brief Sets all pixels of an overlay layer to the given color
+         *
+         * @param layer Overlay layer to modify (EFLED_OVERLAY_*)
+         * @param color Color to set
+         * @param alpha Opacity of all pixels (0: transparent, 255: opaque)
+         */
+        void fillOverlay(const uint8_t layer, const CRGB color, const uint8_t alpha = 255);
+
+        /**
+         * @brief Makes all pixels of an overlay layer transparent, revealing the
+         * layers below again
+         *
+         * @param layer Overlay layer to clear (EFLED_OVERLAY_*)
+         */
+        void clearOverlay(const uint8_t layer);
+
+        /**
+         * @brief Sets how the pixels of an overlay layer are combined with the pixels below
+         *
+         * @param layer Overlay layer to modify (EFLED_OVERLAY_*)
+         * @param mode Blend mode to use
+         */
+        void setOverlayBlendMode(const uint8_t layer, const EFLedBlendMode mode);
+
+        /**
+         * @brief Retrieves the timeline that renders into the given overlay layer.
+         * Use reset() and add() to build an effect, then play it with playTimeline().
+         *
+         * @param layer Overlay layer of the timeline (EFLED_OVERLAY_*)
+         * @return Timeline of the given layer
+         */
+        EFLedTimeline& getTimeline(const uint8_t layer);
+
+        /**
+         * @brief Starts playing the timeline of the given overlay layer. The effect is
+         * advanced by update() without blocking the caller.
+         *
+         * @param layer Overlay layer of the timeline (EFLED_OVERLAY_*)
+         */
+        void playTimeline(const uint8_t layer);
+
+        /**
+         * @brief Stops the timeline of the given overlay layer and clears the layer
+         *
+         * @param layer Overlay layer of the timeline (EFLED_OVERLAY_*)
+         */
+        void stopTimeline(const uint8_t layer);
+
+        /**
+         * @brief Determines if the timeline of the given overlay layer is playing
+         *
+         * @param layer Overlay layer of the timeline (EFLED_OVERLAY_*)
+         * @return True, if the timeline is still playing
+         */
+        bool isTimelineRunning(const uint8_t layer) const;
+
+        /**
+         * @brief Advances all playing timelines and a running cross-fade and presents
+         * the result. Gates the +5V power domain if the LEDs were dark long enough.
+         * Must be called regularly from the main loop.
+         */
+        void update();
+
         /**
          * @brief Gets the position of the LED in millimeters relative to the upper left corner of the badge
          *
@@ -0,0 +1,231 @@
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <esp_partition.h>
+
+#include <EFLogging.h>
+
+#include "EFLedAnimation.h"
+
+/**
+ * @brief Reads a little-endian 16-bit value
+ */
+static inline uint16_t _read16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+/**
+ * @brief Reads a little-endian 32-bit value
+ */
+static inline uint32_t _read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+EFLedAnimation::EFLedAnimation()
+: mmap_handle(0)
+, data(nullptr)
+, size(0)
+, count(0)
+, num_frames(0)
+, loop_frame(0)
+, loop(false)
+, pos(0)
+, loop_pos(0)
+, frame_idx(0)
+, frame(nullptr)
+, buffer({0})
+, name({0})
+{
+}
+
+EFLedAnimation::~EFLedAnimation() {
+    this->close();
+}
+
+bool EFLedAnimation::open(const uint8_t idx) {
+    this->close();
+
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA,
+        (esp_partition_subtype_t) EFLED_ANIMATION_PARTITION_SUBTYPE,
+        EFLED_ANIMATION_PARTITION_LABEL
+    );
+    if (partition == nullptr) {
+        LOG_WARNING("(EFLedAnimation) Animation partition not found");
+        return false;
+    }
+
+    // Read directory entry. Only the directory is mapped for this.
+    const void* ptr;
+    spi_flash_mmap_handle_t handle;
+    const size_t dir_size = EFLED_ANIMATION_PARTITION_HEADER_SIZE + 255 * EFLED_ANIMATION_DIRECTORY_ENTRY_SIZE;
+    if (esp_partition_mmap(partition, 0, dir_size, SPI_FLASH_MMAP_DATA, &ptr, &handle) != ESP_OK) {
+        LOG_ERROR("(EFLedAnimation) Failed to map animation directory");
+        return false;
+    }
+    const uint8_t* dir = static_cast<const uint8_t*>(ptr);
+    if (memcmp(dir, EFLED_ANIMATION_PARTITION_MAGIC, 4) != 0 || dir[4] != EFLED_ANIMATION_VERSION) {
+        LOG_WARNING("(EFLedAnimation) Animation partition is empty or has an unsupported version");
+        spi_flash_munmap(handle);
+        return false;
+    }
+    this->count = dir[5];
+    if (idx >= this->count) {
+        LOGF_WARNING("(EFLedAnimation) Animation %d not found. Partition holds %d animations.\r\n", idx, this->count);
+        spi_flash_munmap(handle);
+        return false;
+    }
+    const uint8_t* entry = dir + EFLED_ANIMATION_PARTITION_HEADER_SIZE + idx * EFLED_ANIMATION_DIRECTORY_ENTRY_SIZE;
+    const uint32_t offset = _read32(entry);
+    const uint32_t size = _read32(entry + 4);
+    spi_flash_munmap(handle);
+
+    if (size < EFLED_ANIMATION_HEADER_SIZE || offset > partition->size || size > partition->size - offset) {
+        LOGF_ERROR("(EFLedAnimation) Invalid directory entry for animation %d\r\n", idx);
+        return false;
+    }
+
+    // Map the animation itself
+    if (esp_partition_mmap(partition, offset, size, SPI_FLASH_MMAP_DATA, &ptr, &this->mmap_handle) != ESP_OK) {
+        LOGF_ERROR("(EFLedAnimation) Failed to map animation %d\r\n", idx);
+        return false;
+    }
+    this->data = static_cast<const uint8_t*>(ptr);
+    this->size = size;
+
+    if (memcmp(this->data, EFLED_ANIMATION_MAGIC, 4) != 0 || this->data[4] != EFLED_ANIMATION_VERSION) {
+        LOGF_ERROR("(EFLedAnimation) Animation %d is corrupt or has an unsupported version\r\n", idx);
+        this->close();
+        return false;
+    }
+    this->loop = this->data[5] & EFLED_ANIMATION_FLAG_LOOP;
+    this->num_frames = _read16(this->data + 6);
+    this->loop_frame = _read16(this->data + 8);
+    memcpy(this->name, this->data + 12, EFLED_ANIMATION_NAME_LEN);
+    this->name[EFLED_ANIMATION_NAME_LEN] = '\0';
+
+    this->rewind();
+    LOGF_INFO("(EFLedAnimation) Opened animation %d: %s (%d frames)\r\n", idx, this->name, this->num_frames);
+    return true;
+}
+
+void EFLedAnimation::close() {
+    if (this->data == nullptr) {
+        return;
+    }
+
+    spi_flash_munmap(this->mmap_handle);
+    this->data = nullptr;
+    this->size = 0;
+    this->frame = nullptr;
+}
+
+bool EFLedAnimation::isOpen() const {
+    return this->data != nullptr;
+}
+
+uint8_t EFLedAnimation::getCount() const {
+    return this->count;
+}
+
+const char* EFLedAnimation::getName() const {
+    return this->name;
+}
+
+void EFLedAnimation::rewind() {
+    this->pos = EFLED_ANIMATION_HEADER_SIZE;
+    this->loop_pos = 0;
+    this->frame_idx = 0;
+    this->frame = this->buffer;
+    fill_solid(this->buffer, EFLED_TOTAL_NUM, CRGB::Black);
+}
+
+const CRGB* EFLedAnimation::next(uint16_t& duration_ms) {
+    if (this->data == nullptr) {
+        return nullptr;
+    }
+
+    // Continue with the loop frame after the last frame
+    if (this->frame_idx >= this->num_frames) {
+        if (!this->loop || this->loop_pos == 0) {
+            return nullptr;
+        }
+        this->pos = this->loop_pos;
+        this->frame_idx = this->loop_frame;
+    }
+    if (this->frame_idx == this->loop_frame) {
+        this->loop_pos = this->pos;
+    }
+
+    // Decode frame header
+    if (this->pos + EFLED_ANIMATION_FRAME_HEADER_SIZE > this->size) {
+        LOGF_ERROR("(EFLedAnimation) Frame %d exceeds animation data\r\n", this->frame_idx);
+        return nullptr;
+    }
+    const uint8_t* p = this->data + this->pos;
+    duration_ms = _read16(p);
+    const uint8_t type = p[2];
+    const uint8_t entries = p[3];
+    p += EFLED_ANIMATION_FRAME_HEADER_SIZE;
+
+    const uint32_t payload = type == EFLED_ANIMATION_FRAME_KEY ? entries * 3 : entries * 4;
+    if (this->pos + EFLED_ANIMATION_FRAME_HEADER_SIZE + payload > this->size) {
+        LOGF_ERROR("(EFLedAnimation) Frame %d exceeds animation data\r\n", this->frame_idx);
+        return nullptr;
+    }
+
+    switch (type) {
+        case EFLED_ANIMATION_FRAME_KEY:
+            if (entries != EFLED_TOTAL_NUM) {
+                LOGF_ERROR("(EFLedAnimation) Keyframe %d has invalid size\r\n", this->frame_idx);
+                return nullptr;
+            }
+            // Shown directly from flash
+            this->frame = reinterpret_cast<const CRGB*>(p);
+            break;
+        case EFLED_ANIMATION_FRAME_DELTA:
+            if (this->frame != this->buffer) {
+                memcpy(this->buffer, this->frame, sizeof(this->buffer));
+                this->frame = this->buffer;
+            }
+            for (uint8_t i = 0; i < entries; i++, p += 4) {
+                if (p[0] < EFLED_TOTAL_NUM) {
+                    this->buffer[p[0]] = CRGB(p[1], p[2], p[3]);
+                }
+            }
+            break;
+        default:
+            LOGF_ERROR("(EFLedAnimation) Frame %d has unknown type %d\r\n", this->frame_idx, type);
+            return nullptr;
+    }
+
+    this->pos += EFLED_ANIMATION_FRAME_HEADER_SIZE + payload;
+    this->frame_idx++;
+    return this->frame;
+}
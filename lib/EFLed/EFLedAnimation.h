@@ -0,0 +1,168 @@
+#ifndef EFLEDANIMATION_H_
+#define EFLEDANIMATION_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <FastLED.h>
+#include <esp_partition.h>
+
+#include "EFLed.h"
+
+/**
+ * @brief Label and subtype of the data partition holding LED animations (see partitions.csv)
+ */
+#define EFLED_ANIMATION_PARTITION_LABEL "anim"
+#define EFLED_ANIMATION_PARTITION_SUBTYPE 0x40
+
+/**
+ * @brief Binary animation format. All values are little-endian. Must match efanim.py.
+ *
+ * Partition image:
+ *   0   4      Magic "EFAP"
+ *   4   1      Version
+ *   5   1      Number of animations N
+ *   6   2      Reserved
+ *   8   8*N    Directory: u32 offset (from partition start) and u32 size of each animation
+ *
+ * Animation:
+ *   0   4      Magic "EFAN"
+ *   4   1      Version
+ *   5   1      Flags (EFLED_ANIMATION_FLAG_*)
+ *   6   2      Number of frames
+ *   8   2      Frame to continue with after the last frame, if looping. Must be a keyframe.
+ *   10  2      Reserved
+ *   12  16     Name, NUL padded
+ *   28  ...    Frames
+ *
+ * Frame:
+ *   0   2      Duration in milliseconds
+ *   2   1      Type (EFLED_ANIMATION_FRAME_*)
+ *   3   1      Number of LED entries C
+ *   4   ...    Keyframe: C = EFLED_TOTAL_NUM RGB triplets
+ *              Delta: C entries of LED index and RGB triplet, applied to the previous frame
+ */
+#define EFLED_ANIMATION_PARTITION_MAGIC "EFAP"
+#define EFLED_ANIMATION_MAGIC "EFAN"
+#define EFLED_ANIMATION_VERSION 1
+#define EFLED_ANIMATION_PARTITION_HEADER_SIZE 8
+#define EFLED_ANIMATION_DIRECTORY_ENTRY_SIZE 8
+#define EFLED_ANIMATION_HEADER_SIZE 28
+#define EFLED_ANIMATION_FRAME_HEADER_SIZE 4
+#define EFLED_ANIMATION_NAME_LEN 16
+
+#define EFLED_ANIMATION_FLAG_LOOP 0x01
+
+#define EFLED_ANIMATION_FRAME_KEY 0
+#define EFLED_ANIMATION_FRAME_DELTA 1
+
+/**
+ * @brief Player for LED animations stored in the animation data partition. The
+ * animation is memory-mapped and decoded frame by frame. Keyframes are shown
+ * directly from flash, delta frames are applied to a single frame buffer.
+ */
+class EFLedAnimation {
+
+    protected:
+
+        spi_flash_mmap_handle_t mmap_handle;  //!< Handle of the mapped animation
+        const uint8_t* data;       //!< Mapped animation data
+        uint32_t size;             //!< Size of the mapped animation in bytes
+        uint8_t count;             //!< Number of animations inside the partition
+        uint16_t num_frames;       //!< Number of frames of the opened animation
+        uint16_t loop_frame;       //!< Frame to continue with after the last frame
+        bool loop;                 //!< True, if the animation loops
+
+        uint32_t pos;              //!< Offset of the next frame
+        uint32_t loop_pos;         //!< Offset of the loop frame, once it was seen
+        uint16_t frame_idx;        //!< Number of the next frame
+        const CRGB* frame;         //!< Current frame. Either inside the mapped data or buffer.
+        CRGB buffer[EFLED_TOTAL_NUM];  //!< Frame buffer delta frames are applied to
+        char name[EFLED_ANIMATION_NAME_LEN + 1];  //!< Name of the opened animation
+
+    public:
+
+        /**
+         * @brief Constructs a new, closed animation player
+         */
+        EFLedAnimation();
+
+        /**
+         * @brief Unmaps the animation, if still opened
+         */
+        ~EFLedAnimation();
+
+        /**
+         * @brief Maps the animation with the given index from the animation partition
+         *
+         * @param idx Number of the animation inside the partition
+         * @return True, if the animation was found and its header is valid
+         */
+        bool open(const uint8_t idx);
+
+        /**
+         * @brief Unmaps the current animation. Frames returned by next() are invalid afterwards.
+         */
+        void close();
+
+        /**
+         * @brief Determines if an animation is currently opened
+         *
+         * @return True, if an animation is mapped
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Retrieves the number of animations inside the partition. Valid after open().
+         *
+         * @return Number of animations
+         */
+        uint8_t getCount() const;
+
+        /**
+         * @brief Retrieves the name of the opened animation
+         *
+         * @return Name of the animation
+         */
+        const char* getName() const;
+
+        /**
+         * @brief Restarts the animation from its first frame
+         */
+        void rewind();
+
+        /**
+         * @brief Decodes the next frame
+         *
+         * @param duration_ms Set to the number of milliseconds the frame should be shown
+         * @return Decoded frame of EFLED_TOTAL_NUM colors, valid until the next call or close().
+         * nullptr if the animation ended or is corrupt.
+         */
+        const CRGB* next(uint16_t& duration_ms);
+};
+
+#endif /* EFLEDANIMATION_H_ */
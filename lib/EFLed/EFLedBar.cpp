@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+/**
+ * @author Honigeintopf
+ */
+
+#include <algorithm>
+
+#include "EFLedBar.h"
+
+namespace {
+
+/**
+ * @brief Calculates how much of the given LED is covered by the level
+ *
+ * @return Coverage between 0 (empty) and EFLEDBAR_SUBSTEPS (full)
+ */
+inline uint16_t coverage(const uint16_t level, const uint8_t idx) {
+    const uint16_t start = idx * EFLEDBAR_SUBSTEPS;
+    if (level <= start) {
+        return 0;
+    }
+    return std::min<uint16_t>(level - start, EFLEDBAR_SUBSTEPS);
+}
+
+/**
+ * @brief Blends between both colors, where amount EFLEDBAR_SUBSTEPS is exactly b
+ */
+inline CRGB blendSubstep(const CRGB a, const CRGB b, const uint16_t amount) {
+    if (amount == 0) {
+        return a;
+    }
+    if (amount >= EFLEDBAR_SUBSTEPS) {
+        return b;
+    }
+    return blend(a, b, amount);
+}
+
+}
+
+void EFLedBar::fill(CRGB* bar, const uint16_t level, const CRGB color_on, const CRGB color_off) {
+    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+        bar[i] = blendSubstep(color_off, color_on, coverage(level, i));
+    }
+}
+
+void EFLedBar::fillGradient(
+    CRGB* bar,
+    const uint16_t level,
+    const CRGB color_first,
+    const CRGB color_last,
+    const CRGB color_off
+) {
+    EFLedBar::gradient(bar, color_first, color_last);
+    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+        bar[i] = blendSubstep(color_off, bar[i], coverage(level, i));
+    }
+}
+
+void EFLedBar::gradient(CRGB* bar, const CRGB color_first, const CRGB color_last) {
+    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+        bar[i] = blend(color_first, color_last, i * 255 / (EFLED_EFBAR_NUM - 1));
+    }
+}
+
+void EFLedBar::cursor(CRGB* bar, const uint16_t pos, const CRGB color_on, const CRGB color_off) {
+    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+        const uint16_t center = i * EFLEDBAR_SUBSTEPS;
+        const uint16_t distance = center > pos ? center - pos : pos - center;
+
+        // Background fades out by 1/4 per LED of distance towards the cursor
+        const CRGB background = color_off.scale8(std::min<uint16_t>(distance / 4, 255));
+        const uint16_t intensity = distance < EFLEDBAR_SUBSTEPS ? EFLEDBAR_SUBSTEPS - distance : 0;
+        bar[i] = blendSubstep(background, color_on, intensity);
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef EFLEDBAR_H_
+#define EFLEDBAR_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief Number of sub-steps between two neighbouring EF bar LEDs
+ */
+#define EFLEDBAR_SUBSTEPS 256
+
+/**
+ * @brief Maximum level of the EF bar: All LEDs fully lit
+ */
+#define EFLEDBAR_LEVEL_MAX (EFLED_EFBAR_NUM * EFLEDBAR_SUBSTEPS)
+
+/**
+ * @brief Integer-only rendering of level and cursor displays on the EF bar.
+ *
+ * Positions are given in 1/EFLEDBAR_SUBSTEPS of an LED. A position between two
+ * LEDs is antialiased by blending both LEDs accordingly, so that a level or
+ * cursor moves smoothly along the bar instead of jumping from LED to LED.
+ * All functions render into a caller-supplied array of EFLED_EFBAR_NUM colors
+ * (from top to bottom), which can then be shown using `EFLed.setEFBar()` or
+ * `EFLed.setOverlayEFBar()`.
+ */
+class EFLedBar {
+
+    public:
+
+        /**
+         * @brief Converts a value within a range to an EF bar level
+         *
+         * @param value Current value (clamped to max)
+         * @param max Value that corresponds to a fully lit EF bar
+         * @return Level between 0 and EFLEDBAR_LEVEL_MAX
+         */
+        static constexpr uint16_t level(const uint32_t value, const uint32_t max) {
+            if (max == 0 || value >= max) {
+                return EFLEDBAR_LEVEL_MAX;
+            }
+            return (uint64_t) value * EFLEDBAR_LEVEL_MAX / max;
+        }
+
+        /**
+         * @brief Fills the EF bar up to the given level. The LED at the edge of
+         * the level is blended between both colors.
+         *
+         * @param bar Array of EFLED_EFBAR_NUM colors to render into
+         * @param level Fill level between 0 and EFLEDBAR_LEVEL_MAX
+         * @param color_on Color to use for filled LEDs
+         * @param color_off Color to use for empty LEDs
+         */
+        static void fill(CRGB* bar, const uint16_t level, const CRGB color_on, const CRGB color_off);
+
+        /**
+         * @brief Same as fill() but filled LEDs show a gradient from color_first
+         * (top) to color_last (bottom), stretched over the whole EF bar.
+         *
+         * @param bar Array of EFLED_EFBAR_NUM colors to render into
+         * @param level Fill level between 0 and EFLEDBAR_LEVEL_MAX
+         * @param color_first Color of the top most LED
+         * @param color_last Color of the bottom most LED
+         * @param color_off Color to use for empty LEDs
+         */
+        static void fillGradient(
+            CRGB* bar,
+            const uint16_t level,
+            const CRGB color_first,
+            const CRGB color_last,
+            const CRGB color_off
+        );
+
+        /**
+         * @brief Shows a gradient from color_first (top) to color_last (bottom)
+         *
+         * @param bar Array of EFLED_EFBAR_NUM colors to render into
+         * @param color_first Color of the top most LED
+         * @param color_last Color of the bottom most LED
+         */
+        static void gradient(CRGB* bar, const CRGB color_first, const CRGB color_last);
+
+        /**
+         * @brief Renders a cursor at the given position. The background fades
+         * out towards the cursor. A cursor between two LEDs lights both of them
+         * proportionally.
+         *
+         * @param bar Array of EFLED_EFBAR_NUM colors to render into
+         * @param pos Cursor position in 1/EFLEDBAR_SUBSTEPS LEDs (0: top most LED,
+         * EFLEDBAR_SUBSTEPS: second LED, ...)
+         * @param color_on Color of the cursor
+         * @param color_off Background color
+         */
+        static void cursor(CRGB* bar, const uint16_t pos, const CRGB color_on, const CRGB color_off);
+
+};
+
+#endif /* EFLEDBAR_H_ */
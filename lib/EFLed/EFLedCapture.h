@@ -0,0 +1,85 @@
+#ifndef EFLEDCAPTURE_H_
+#define EFLEDCAPTURE_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief Number of frames kept by the capture ring buffer. Only used if
+ * EFLED_ENABLE_CAPTURE is defined.
+ */
+#ifndef EFLED_CAPTURE_NUM
+#define EFLED_CAPTURE_NUM 128
+#endif
+
+/**
+ * @brief Capture entry flags
+ */
+#define EFLED_CAPTURE_FLAG_SKIPPED 0x01  //!< Frame was identical to the frame shown by the LEDs and not transmitted
+#define EFLED_CAPTURE_FLAG_GATED 0x02    //!< Frame was dark while LED power was gated and not transmitted
+
+/**
+ * @brief Serial dump of the capture ring buffer. All values are little-endian.
+ * Must match efcapture.py.
+ *
+ * Header:
+ *   0   4      Magic "EFCP"
+ *   4   1      Version
+ *   5   1      Number of LEDs L
+ *   6   2      Number of entries N
+ *   8   4      Timestamp of the dump in microseconds
+ *
+ * Entry, N times from oldest to newest:
+ *   0   4      Timestamp in microseconds (micros(), wraps after approx. 71 minutes)
+ *   4   2      Sequence number of the presented frame
+ *   6   1      Brightness the frame was shown with, after current limiting (0-255)
+ *   7   1      Flags (EFLED_CAPTURE_FLAG_*)
+ *   8   3*L    RGB values sent to the LEDs
+ *
+ * Footer:
+ *   0   4      Sum of all header and entry bytes
+ */
+#define EFLED_CAPTURE_MAGIC "EFCP"
+#define EFLED_CAPTURE_VERSION 1
+
+/**
+ * @brief A single captured frame, as it was handed to the output task
+ */
+struct EFLedCaptureEntry {
+    uint32_t timestamp_us;       //!< Time the frame was presented
+    uint16_t seq;                //!< Sequence number of the presented frame
+    uint8_t brightness;          //!< Brightness the frame was shown with, after current limiting
+    uint8_t flags;               //!< EFLED_CAPTURE_FLAG_*
+    CRGB leds[EFLED_TOTAL_NUM];  //!< Colors sent to the LEDs, after brightness and dithering
+};
+
+#endif /* EFLEDCAPTURE_H_ */
@@ -0,0 +1,273 @@
+#ifndef EFLEDCOLOR_H_
+#define EFLEDCOLOR_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+
+/**
+ * @brief Color math usable in constant expressions. Mirrors the FastLED functions
+ * of the same name, so tables can be pre-rendered by the compiler and still look
+ * exactly like colors converted at runtime.
+ */
+class EFLedColor {
+
+    public:
+
+        /**
+         * @brief Plain RGB triplet with the same memory layout as CRGB
+         */
+        struct RGB {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+
+        /**
+         * @brief Same as FastLEDs scale8()
+         */
+        static constexpr uint8_t scale8(const uint8_t i, const uint8_t scale) {
+            return (static_cast<uint16_t>(i) * (1 + static_cast<uint16_t>(scale))) >> 8;
+        }
+
+        /**
+         * @brief Same as FastLEDs scale8_video()
+         */
+        static constexpr uint8_t scale8_video(const uint8_t i, const uint8_t scale) {
+            return ((static_cast<uint16_t>(i) * scale) >> 8) + ((i && scale) ? 1 : 0);
+        }
+
+        /**
+         * @brief Same as FastLEDs hsv2rgb_rainbow(), which is used for implicit
+         * CHSV to CRGB conversions
+         *
+         * @param hue Hue (0-255)
+         * @param sat Saturation (0-255)
+         * @param val Value (0-255)
+         * @return Converted color
+         */
+        static constexpr RGB hsv2rgb(const uint8_t hue, const uint8_t sat, const uint8_t val) {
+            const uint8_t offset8 = (hue & 0x1F) << 3;
+            const uint8_t third = scale8(offset8, 256 / 3);
+            const uint8_t twothirds = scale8(offset8, (256 * 2) / 3);
+            uint8_t r = 0;
+            uint8_t g = 0;
+            uint8_t b = 0;
+
+            switch (hue >> 5) {
+                case 0: r = 255 - third; g = third;           b = 0;               break;  // R -> O
+                case 1: r = 171;         g = 85 + third;      b = 0;               break;  // O -> Y
+                case 2: r = 171 - twothirds; g = 170 + third; b = 0;               break;  // Y -> G
+                case 3: r = 0;           g = 255 - third;     b = third;           break;  // G -> A
+                case 4: r = 0;           g = 171 - twothirds; b = 85 + twothirds;  break;  // A -> B
+                case 5: r = third;       g = 0;               b = 255 - third;     break;  // B -> P
+                case 6: r = 85 + third;  g = 0;               b = 171 - third;     break;  // P -> K
+                case 7: r = 170 + third; g = 0;               b = 85 - third;      break;  // K -> R
+            }
+
+            // Desaturate
+            if (sat != 255) {
+                if (sat == 0) {
+                    r = 255;
+                    g = 255;
+                    b = 255;
+                } else {
+                    const uint8_t desat = scale8_video(255 - sat, 255 - sat);
+                    const uint8_t satscale = 255 - desat;
+                    r = scale8(r, satscale) + desat;
+                    g = scale8(g, satscale) + desat;
+                    b = scale8(b, satscale) + desat;
+                }
+            }
+
+            // Dim
+            if (val != 255) {
+                const uint8_t v = scale8_video(val, val);
+                if (v == 0) {
+                    r = 0;
+                    g = 0;
+                    b = 0;
+                } else {
+                    r = scale8(r, v);
+                    g = scale8(g, v);
+                    b = scale8(b, v);
+                }
+            }
+
+            return {r, g, b};
+        }
+
+        /**
+         * @brief Converts a hex color code (0xRRGGBB) into an RGB triplet
+         */
+        static constexpr RGB hex(const uint32_t code) {
+            return {
+                static_cast<uint8_t>((code >> 16) & 0xFF),
+                static_cast<uint8_t>((code >> 8) & 0xFF),
+                static_cast<uint8_t>(code & 0xFF)
+            };
+        }
+
+        /**
+         * @brief Interpolates between two sRGB colors in the perceptual OKLab
+         * color space. Intermediate colors keep their lightness and saturation
+         * instead of turning muddy or grey, as linear RGB blending does.
+         *
+         * Only meant for pre-rendering tables in constant expressions. It is far
+         * too slow to be used at runtime.
+         *
+         * @param a First color
+         * @param b Second color
+         * @param t Amount of b (0.0: only a, 1.0: only b)
+         * @return Interpolated color
+         */
+        static constexpr RGB mixOKLab(const RGB a, const RGB b, const double t) {
+            const Lab la = toOKLab(a);
+            const Lab lb = toOKLab(b);
+            return fromOKLab({
+                la.L + (lb.L - la.L) * t,
+                la.a + (lb.a - la.a) * t,
+                la.b + (lb.b - la.b) * t
+            });
+        }
+
+    private:
+
+        struct Lab {
+            double L;
+            double a;
+            double b;
+        };
+
+        static constexpr double ln(double x) {
+            constexpr double ln2 = 0.69314718055994530942;
+            if (x <= 0.0) {
+                return -1e300;
+            }
+
+            // Reduce x to [1, 2) and use ln(x) = 2 * atanh((x - 1) / (x + 1))
+            int16_t exponent = 0;
+            while (x >= 2.0) {
+                x /= 2.0;
+                exponent++;
+            }
+            while (x < 1.0) {
+                x *= 2.0;
+                exponent--;
+            }
+
+            const double z = (x - 1.0) / (x + 1.0);
+            double term = z;
+            double sum = 0.0;
+            for (uint8_t i = 0; i < 24; i++) {
+                sum += term / (2 * i + 1);
+                term *= z * z;
+            }
+            return 2.0 * sum + exponent * ln2;
+        }
+
+        static constexpr double exp(double x) {
+            constexpr double ln2 = 0.69314718055994530942;
+
+            // Reduce x to [-ln2 / 2, ln2 / 2] and use e^x = 2^n * e^r
+            const int16_t n = static_cast<int16_t>(x / ln2 + (x < 0.0 ? -0.5 : 0.5));
+            const double r = x - n * ln2;
+
+            double term = 1.0;
+            double sum = 1.0;
+            for (uint8_t i = 1; i < 20; i++) {
+                term *= r / i;
+                sum += term;
+            }
+            for (int16_t i = 0; i < n; i++) {
+                sum *= 2.0;
+            }
+            for (int16_t i = 0; i > n; i--) {
+                sum /= 2.0;
+            }
+            return sum;
+        }
+
+        static constexpr double pow(const double x, const double y) {
+            return x <= 0.0 ? 0.0 : exp(y * ln(x));
+        }
+
+        static constexpr double cbrt(const double x) {
+            return x < 0.0 ? -pow(-x, 1.0 / 3.0) : pow(x, 1.0 / 3.0);
+        }
+
+        static constexpr double toLinear(const uint8_t c) {
+            const double v = c / 255.0;
+            return v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4);
+        }
+
+        static constexpr uint8_t fromLinear(const double c) {
+            const double v = c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+            if (v <= 0.0) {
+                return 0;
+            }
+            if (v >= 1.0) {
+                return 255;
+            }
+            return static_cast<uint8_t>(v * 255.0 + 0.5);
+        }
+
+        static constexpr Lab toOKLab(const RGB c) {
+            const double r = toLinear(c.r);
+            const double g = toLinear(c.g);
+            const double b = toLinear(c.b);
+
+            const double l = cbrt(0.4122214708 * r + 0.5363325363 * g + 0.0514459929 * b);
+            const double m = cbrt(0.2119034982 * r + 0.6806995451 * g + 0.1073969566 * b);
+            const double s = cbrt(0.0883024619 * r + 0.2817188376 * g + 0.6299787005 * b);
+
+            return {
+                0.2104542553 * l + 0.7936177850 * m - 0.0040720468 * s,
+                1.9779984951 * l - 2.4285922050 * m + 0.4505937099 * s,
+                0.0259040371 * l + 0.7827717662 * m - 0.8086757660 * s
+            };
+        }
+
+        static constexpr RGB fromOKLab(const Lab c) {
+            const double l_ = c.L + 0.3963377774 * c.a + 0.2158037573 * c.b;
+            const double m_ = c.L - 0.1055613458 * c.a - 0.0638541728 * c.b;
+            const double s_ = c.L - 0.0894841775 * c.a - 1.2914855480 * c.b;
+
+            const double l = l_ * l_ * l_;
+            const double m = m_ * m_ * m_;
+            const double s = s_ * s_ * s_;
+
+            return {
+                fromLinear(+4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s),
+                fromLinear(-1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s),
+                fromLinear(-0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s)
+            };
+        }
+};
+
+#endif /* EFLEDCOLOR_H_ */
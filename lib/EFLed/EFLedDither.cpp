@@ -0,0 +1,82 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <string.h>
+
+#include "EFLedDither.h"
+#include "EFLedKernels.h"
+
+EFLedDither::EFLedDither()
+: error({{0}})
+, static_frames(0)
+, pending(false)
+{
+}
+
+void EFLedDither::reset() {
+    memset(this->error, 0, sizeof(this->error));
+    this->static_frames = 0;
+    this->pending = false;
+}
+
+void EFLedDither::apply(
+    const uint16_t linear[EFLED_TOTAL_NUM][3],
+    const uint16_t scale,
+    const bool unchanged,
+    CRGB out[EFLED_TOTAL_NUM]
+) {
+    if (!unchanged) {
+        this->static_frames = 0;
+    } else if (this->static_frames < EFLED_DITHER_SETTLE_FRAMES) {
+        this->static_frames++;
+    }
+    const bool settled = this->static_frames >= EFLED_DITHER_SETTLE_FRAMES;
+
+    uint16_t scaled[EFLED_TOTAL_NUM][3];
+    EFLedKernels::scale16(&linear[0][0], &scaled[0][0], EFLED_TOTAL_NUM * 3, scale);
+
+    bool pending = false;
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            const uint32_t value = scaled[i][c];
+            if (settled || value >= (EFLED_DITHER_MAX_LEVEL << 8)) {
+                // Round to the nearest level. The last level is only reached by 0xFF80 and above.
+                out[i].raw[c] = value >= 0xFF80 ? 0xFF : (value + 0x80) >> 8;
+                this->error[i][c] = 0;
+            } else {
+                const uint32_t acc = value + this->error[i][c];
+                out[i].raw[c] = acc >> 8;
+                this->error[i][c] = acc & 0xFF;
+                pending |= (value & 0xFF) != 0;
+            }
+        }
+    }
+    this->pending = pending;
+}
+
+bool EFLedDither::isPending() const {
+    return this->pending;
+}
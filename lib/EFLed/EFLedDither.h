@@ -0,0 +1,95 @@
+#ifndef EFLEDDITHER_H_
+#define EFLEDDITHER_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief 8-bit output level below which channels are dithered. A step of one
+ * level is visible on dim channels only, brighter channels are rounded.
+ */
+#define EFLED_DITHER_MAX_LEVEL 64
+
+/**
+ * @brief Number of consecutive unchanged frames after which dithering stops and
+ * the frame settles to its rounded levels (0.5 s at 100 Hz). Static screens are
+ * not retransmitted afterwards.
+ */
+#define EFLED_DITHER_SETTLE_FRAMES 50
+
+/**
+ * @brief Quantizes linear 16-bit frames to 8 bit. The quantization error of
+ * dim channels is carried over to the next frame (temporal dithering), so
+ * intermediate levels are preserved on average while the frame changes.
+ */
+class EFLedDither {
+
+    protected:
+
+        uint8_t error[EFLED_TOTAL_NUM][3];  //!< Quantization error carried over to the next frame
+        uint8_t static_frames;              //!< Number of consecutive unchanged frames
+        bool pending;                       //!< True, if the next frame would differ from the last one
+
+    public:
+
+        /**
+         * @brief Constructs a new dither without any carried over error
+         */
+        EFLedDither();
+
+        /**
+         * @brief Discards the carried over error
+         */
+        void reset();
+
+        /**
+         * @brief Scales a linear frame by the given brightness and quantizes it to 8 bit
+         *
+         * @param linear Linear frame (0-65535 per channel)
+         * @param scale Brightness as 16-bit scale (0-65535)
+         * @param unchanged True, if linear and scale are the same as in the last call
+         * @param out Destination for the 8-bit frame
+         */
+        void apply(const uint16_t linear[EFLED_TOTAL_NUM][3], const uint16_t scale, const bool unchanged, CRGB out[EFLED_TOTAL_NUM]);
+
+        /**
+         * @brief Determines if an unchanged frame still needs to be presented
+         * again to show its exact levels
+         *
+         * @return True, if dithering has not settled yet
+         */
+        bool isPending() const;
+
+};
+
+#endif /* EFLEDDITHER_H_ */
@@ -0,0 +1,82 @@
+#ifndef EFLEDFRAMES_H_
+#define EFLEDFRAMES_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLed.h"
+#include "EFLedColor.h"
+
+static_assert(sizeof(CRGB) == sizeof(EFLedColor::RGB), "CRGB must be a plain RGB triplet");
+
+/**
+ * @brief Sequence of pre-rendered full frames. Meant to be built by a constexpr
+ * function, so the frames are rendered by the compiler and stored in flash.
+ * Frames are played back by handing them to EFLed.setDataSource().
+ *
+ * @tparam N Number of frames
+ */
+template<size_t N>
+struct EFLedFrames {
+    EFLedColor::RGB frames[N][EFLED_TOTAL_NUM];
+
+    constexpr size_t size() const {
+        return N;
+    }
+
+    const CRGB* operator[](const size_t idx) const {
+        return reinterpret_cast<const CRGB*>(this->frames[idx % N]);
+    }
+};
+
+/**
+ * @brief Sequence of pre-rendered palette index frames. Meant to be built by a
+ * constexpr function, so the frames are rendered by the compiler and stored in
+ * flash. Frames are played back in indexed mode by handing them to
+ * EFLed.setIndexSource().
+ *
+ * @tparam N Number of frames
+ */
+template<size_t N>
+struct EFLedIndexFrames {
+    uint8_t frames[N][EFLED_TOTAL_NUM];
+
+    constexpr size_t size() const {
+        return N;
+    }
+
+    constexpr const uint8_t* operator[](const size_t idx) const {
+        return this->frames[idx % N];
+    }
+};
+
+#endif /* EFLEDFRAMES_H_ */
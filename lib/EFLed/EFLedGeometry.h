@@ -0,0 +1,350 @@
+#ifndef EFLEDGEOMETRY_H_
+#define EFLEDGEOMETRY_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief Origin of the boop-up wave in millimeters, relative to the upper left
+ * corner of the badge. Outside of the PCB, where the hand holding the power button is.
+ */
+#define EFLED_GEOMETRY_BOOP_X -30
+#define EFLED_GEOMETRY_BOOP_Y 16
+
+/**
+ * @brief Fixed point shift of all distance tables. Distances are stored in 1/16 mm.
+ */
+#define EFLED_GEOMETRY_DIST_SHIFT 4
+
+/**
+ * @brief LED positions and constexpr math used to derive the geometry tables in
+ * EFLedGeometry. The tables can only be evaluated after this class is complete.
+ */
+class EFLedGeometryBuilder {
+
+    public:
+
+        /**
+         * @brief Position of a single LED in millimeters
+         */
+        struct Point {
+            int16_t x;
+            int16_t y;
+        };
+
+        /**
+         * @brief Positions of all LEDs in millimeters relative to the upper left corner of the badge
+         */
+        static constexpr Point positions[EFLED_TOTAL_NUM] = {
+            {17, 126},  // 0
+            {21, 106},
+            {23, 91},
+            {41, 86},
+            {35, 48},
+            {37, 43},  // 5
+            {61, 15},
+            {61, 27},
+            {61, 41},
+            {61, 54},
+            {61, 67},  // 10
+            {61, 79},
+            {61, 93},
+            {61, 105},
+            {61, 118},
+            {61, 131},  // 15
+            {61, 144}
+        };
+
+        /**
+         * @brief Square root, usable in constant expressions (Newton-Raphson)
+         *
+         * @param x Value to take the square root of. Must be >= 0.
+         * @return Square root of x
+         */
+        static constexpr double sqrt(const double x) {
+            if (x <= 0.0) {
+                return 0.0;
+            }
+
+            double r = x > 1.0 ? x : 1.0;
+            for (uint8_t i = 0; i < 64; i++) {
+                const double next = 0.5 * (r + x / r);
+                if (next == r) {
+                    break;
+                }
+                r = next;
+            }
+            return r;
+        }
+
+        /**
+         * @brief Sine, usable in constant expressions (Taylor series after range reduction)
+         *
+         * @param x Angle in radians
+         * @return Sine of x
+         */
+        static constexpr double sin(double x) {
+            constexpr double pi = 3.14159265358979323846;
+            while (x > pi) {
+                x -= 2.0 * pi;
+            }
+            while (x < -pi) {
+                x += 2.0 * pi;
+            }
+
+            double term = x;
+            double sum = x;
+            for (uint8_t i = 1; i < 12; i++) {
+                term *= -x * x / ((2 * i) * (2 * i + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Arc tangent of y/x, usable in constant expressions. Accurate to
+         * approx. 0.1 degrees, which is plenty for 8-bit angles.
+         *
+         * @param y Y component
+         * @param x X component
+         * @return Angle in radians between -pi and pi
+         */
+        static constexpr double atan2(const double y, const double x) {
+            constexpr double pi = 3.14159265358979323846;
+            if (x == 0.0 && y == 0.0) {
+                return 0.0;
+            }
+
+            const double ax = x < 0.0 ? -x : x;
+            const double ay = y < 0.0 ? -y : y;
+            const double z = ax > ay ? ay / ax : ax / ay;
+            double a = pi / 4.0 * z - z * (z - 1.0) * (0.2447 + 0.0663 * z);
+            if (ay > ax) {
+                a = pi / 2.0 - a;
+            }
+            if (x < 0.0) {
+                a = pi - a;
+            }
+            return y < 0.0 ? -a : a;
+        }
+
+        /**
+         * @brief Distance between two points in 1/16 mm
+         */
+        static constexpr uint16_t distance(const double x0, const double y0, const double x1, const double y1) {
+            return static_cast<uint16_t>(
+                sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0)) * (1 << EFLED_GEOMETRY_DIST_SHIFT) + 0.5
+            );
+        }
+
+        /**
+         * @brief Center of mass of all LEDs. Reference point for polar coordinates.
+         */
+        static constexpr Point centroid() {
+            int32_t x = 0;
+            int32_t y = 0;
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                x += positions[i].x;
+                y += positions[i].y;
+            }
+            return {static_cast<int16_t>(x / EFLED_TOTAL_NUM), static_cast<int16_t>(y / EFLED_TOTAL_NUM)};
+        }
+
+        /**
+         * @brief Smallest rectangle containing all LEDs
+         */
+        static constexpr Point bounds_min() {
+            Point p = positions[0];
+            for (uint8_t i = 1; i < EFLED_TOTAL_NUM; i++) {
+                p.x = positions[i].x < p.x ? positions[i].x : p.x;
+                p.y = positions[i].y < p.y ? positions[i].y : p.y;
+            }
+            return p;
+        }
+        static constexpr Point bounds_max() {
+            Point p = positions[0];
+            for (uint8_t i = 1; i < EFLED_TOTAL_NUM; i++) {
+                p.x = positions[i].x > p.x ? positions[i].x : p.x;
+                p.y = positions[i].y > p.y ? positions[i].y : p.y;
+            }
+            return p;
+        }
+
+        /**
+         * @brief Table of one 8-bit value per LED
+         */
+        struct Table8 {
+            uint8_t v[EFLED_TOTAL_NUM];
+            constexpr uint8_t operator[](const uint8_t idx) const { return v[idx]; }
+        };
+
+        /**
+         * @brief Table of one 16-bit value per LED
+         */
+        struct Table16 {
+            uint16_t v[EFLED_TOTAL_NUM];
+            constexpr uint16_t operator[](const uint8_t idx) const { return v[idx]; }
+        };
+
+        /**
+         * @brief Table of one 16-bit value per pair of LEDs
+         */
+        struct Table16x16 {
+            uint16_t v[EFLED_TOTAL_NUM][EFLED_TOTAL_NUM];
+            constexpr const uint16_t* operator[](const uint8_t idx) const { return v[idx]; }
+        };
+
+        /**
+         * @brief Builds the distances of all LEDs to an arbitrary point
+         *
+         * @param x X coordinate of the point in millimeters
+         * @param y Y coordinate of the point in millimeters
+         * @return Distance of each LED in 1/16 mm
+         */
+        static constexpr Table16 distancesFrom(const int16_t x, const int16_t y) {
+            Table16 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                t.v[i] = distance(x, y, positions[i].x, positions[i].y);
+            }
+            return t;
+        }
+
+        static constexpr Table16x16 buildPairwise() {
+            Table16x16 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                for (uint8_t j = 0; j < EFLED_TOTAL_NUM; j++) {
+                    t.v[i][j] = distance(positions[i].x, positions[i].y, positions[j].x, positions[j].y);
+                }
+            }
+            return t;
+        }
+
+        static constexpr Table8 buildAngles() {
+            constexpr double pi = 3.14159265358979323846;
+            constexpr Point c = centroid();
+            Table8 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                double a = atan2(positions[i].y - c.y, positions[i].x - c.x);
+                a = a < 0.0 ? a + 2.0 * pi : a;
+                t.v[i] = static_cast<uint8_t>(static_cast<uint16_t>(a / (2.0 * pi) * 256.0 + 0.5) & 0xFF);
+            }
+            return t;
+        }
+
+        static constexpr Table16 buildRadii() {
+            constexpr Point c = centroid();
+            return distancesFrom(c.x, c.y);
+        }
+
+        static constexpr Table8 buildNormalizedRadii() {
+            constexpr Table16 r = buildRadii();
+            uint16_t hi = 0;
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                hi = r[i] > hi ? r[i] : hi;
+            }
+            Table8 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                t.v[i] = static_cast<uint8_t>((uint32_t) r[i] * 255 / hi);
+            }
+            return t;
+        }
+
+        static constexpr Table8 buildNormalizedX() {
+            constexpr Point lo = bounds_min();
+            constexpr Point hi = bounds_max();
+            Table8 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                t.v[i] = static_cast<uint8_t>((positions[i].x - lo.x) * 255 / (hi.x - lo.x));
+            }
+            return t;
+        }
+
+        static constexpr Table8 buildNormalizedY() {
+            constexpr Point lo = bounds_min();
+            constexpr Point hi = bounds_max();
+            Table8 t = {};
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                t.v[i] = static_cast<uint8_t>((positions[i].y - lo.y) * 255 / (hi.y - lo.y));
+            }
+            return t;
+        }
+};
+
+/**
+ * @brief Compile-time LED geometry of the badge. All tables are derived from the
+ * LED positions by the compiler and live in flash, so spatial effects only need
+ * table lookups at runtime.
+ */
+class EFLedGeometry : public EFLedGeometryBuilder {
+
+    public:
+
+        /**
+         * @brief Distance between each pair of LEDs in 1/16 mm. Use as pairwise[from][to].
+         */
+        static constexpr Table16x16 pairwise = buildPairwise();
+
+        /**
+         * @brief Distance of each LED to the origin of the boop-up wave in 1/16 mm
+         */
+        static constexpr Table16 boop_distance = distancesFrom(EFLED_GEOMETRY_BOOP_X, EFLED_GEOMETRY_BOOP_Y);
+
+        /**
+         * @brief Angle of each LED around the centroid. 0-255 is one full turn,
+         * 0 points to the right, angles grow clockwise.
+         */
+        static constexpr Table8 angle = buildAngles();
+
+        /**
+         * @brief Distance of each LED to the centroid in 1/16 mm. Together with
+         * angle, these are the polar coordinates of all LEDs.
+         */
+        static constexpr Table16 radius = buildRadii();
+
+        /**
+         * @brief Distance of each LED to the centroid, scaled to 0-255 up to the
+         * outermost LED
+         */
+        static constexpr Table8 norm_radius = buildNormalizedRadii();
+
+        /**
+         * @brief Position of each LED, scaled to 0-255 across the bounding box of all LEDs
+         */
+        static constexpr Table8 norm_x = buildNormalizedX();
+        static constexpr Table8 norm_y = buildNormalizedY();
+};
+
+static_assert(EFLedGeometry::pairwise[EFLED_DRAGON_EYE_IDX][EFLED_DRAGON_EYE_IDX] == 0, "LED distance to itself must be 0");
+static_assert(EFLedGeometry::pairwise[6][16] == (144 - 15) << EFLED_GEOMETRY_DIST_SHIFT, "EF bar spans 129 mm");
+static_assert(EFLedGeometry::pairwise[0][16] == EFLedGeometry::pairwise[16][0], "LED distances must be symmetric");
+static_assert(EFLedGeometry::norm_y[6] == 0 && EFLedGeometry::norm_y[16] == 255, "EF bar spans the badge vertically");
+
+#endif /* EFLEDGEOMETRY_H_ */
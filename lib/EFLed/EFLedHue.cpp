@@ -0,0 +1,41 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include "EFLedHue.h"
+
+static_assert(EFLedColor::hsv2rgb(0, 255, 255).r == 255, "Hue 0 must be red");
+static_assert(EFLedColor::hsv2rgb(96, 255, 255).g == 255, "Hue 96 must be green");
+static_assert(EFLedColor::hsv2rgb(160, 255, 255).b == 255, "Hue 160 must be blue");
+
+static constexpr EFLedHue::Table buildTable() {
+    EFLedHue::Table table = {};
+    for (uint16_t hue = 0; hue < 256; hue++) {
+        table.colors[hue] = EFLedColor::hsv2rgb(hue, 255, 255);
+    }
+    return table;
+}
+
+const EFLedHue::Table EFLedHue::table = buildTable();
@@ -0,0 +1,133 @@
+#ifndef EFLEDHUE_H_
+#define EFLEDHUE_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLedColor.h"
+
+static_assert(sizeof(CRGB) == sizeof(EFLedColor::RGB), "CRGB must be a plain RGB triplet");
+
+/**
+ * @brief Fixed list of colors that is resolved by the compiler and stored in
+ * flash. Entries are usually created using EFLedColor::hsv2rgb().
+ *
+ * @tparam N Number of colors
+ */
+template<size_t N>
+struct EFLedColors {
+    EFLedColor::RGB colors[N];
+
+    constexpr size_t size() const {
+        return N;
+    }
+
+    const CRGB& operator[](const size_t idx) const {
+        return reinterpret_cast<const CRGB*>(this->colors)[idx];
+    }
+
+    const CRGB* data() const {
+        return reinterpret_cast<const CRGB*>(this->colors);
+    }
+};
+
+/**
+ * @brief Fully saturated hues, pre-rendered by the compiler. Replaces runtime
+ * CHSV to CRGB conversions with a table lookup and yields the exact same colors.
+ */
+class EFLedHue {
+
+    public:
+
+        /**
+         * @brief Lookup table of all 256 hues at full saturation and value
+         */
+        struct Table {
+            EFLedColor::RGB colors[256];
+        };
+        static const Table table;
+
+        /**
+         * @brief Same as CRGB(CHSV(hue, 255, 255))
+         *
+         * @param hue Hue (0-255)
+         * @return Color of the given hue
+         */
+        static const CRGB& get(const uint8_t hue) {
+            return reinterpret_cast<const CRGB*>(table.colors)[hue];
+        }
+
+        /**
+         * @brief Same as CRGB(CHSV(hue, 255, value))
+         *
+         * @param hue Hue (0-255)
+         * @param value Value (0-255)
+         * @return Color of the given hue, dimmed to value
+         */
+        static CRGB get(const uint8_t hue, const uint8_t value) {
+            return dim(get(hue), value);
+        }
+
+        /**
+         * @brief Color of a hue with 8 additional fractional bits. Blends
+         * between both neighbouring hues, so that slow hue sweeps are smooth.
+         *
+         * @param hue Hue in 1/256 steps (0-65535)
+         * @return Interpolated color
+         */
+        static CRGB get16(const uint16_t hue) {
+            return blend(get(hue >> 8), get((hue >> 8) + 1), hue & 0xFF);
+        }
+
+        /**
+         * @brief Dims a color the same way a CHSV to CRGB conversion applies its
+         * value, e.g., dim(CHSV(h, s, 255), v) == CHSV(h, s, v)
+         *
+         * @param color Color at full value
+         * @param value Value (0-255)
+         * @return Dimmed color
+         */
+        static CRGB dim(const CRGB& color, const uint8_t value) {
+            if (value == 255) {
+                return color;
+            }
+
+            const uint8_t v = EFLedColor::scale8_video(value, value);
+            if (v == 0) {
+                return CRGB(0, 0, 0);
+            }
+            return CRGB(EFLedColor::scale8(color.r, v), EFLedColor::scale8(color.g, v), EFLedColor::scale8(color.b, v));
+        }
+
+};
+
+#endif /* EFLEDHUE_H_ */
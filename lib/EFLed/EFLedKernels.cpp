@@ -0,0 +1,241 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <string.h>
+
+#include "EFLedKernels.h"
+
+#if EFLED_KERNELS_SWAR
+namespace {
+
+constexpr uint32_t LANES_EVEN = 0x00FF00FF;
+constexpr uint32_t LANES_ODD = 0xFF00FF00;
+constexpr uint32_t LOW7 = 0x7F7F7F7F;
+constexpr uint32_t HIGH1 = 0x80808080;
+
+inline bool isAligned(const void* ptr) {
+    return (reinterpret_cast<uintptr_t>(ptr) & 3) == 0;
+}
+
+inline uint32_t load(const uint8_t* ptr) {
+    uint32_t word;
+    memcpy(&word, __builtin_assume_aligned(ptr, 4), sizeof(word));
+    return word;
+}
+
+inline void store(uint8_t* ptr, const uint32_t word) {
+    memcpy(__builtin_assume_aligned(ptr, 4), &word, sizeof(word));
+}
+
+/**
+ * @brief Computes (x * factor) >> 8 for each byte of the word. Each product
+ * is calculated inside a 16-bit lane, so factor must not exceed 256.
+ */
+inline uint32_t mulhi(const uint32_t word, const uint32_t factor) {
+    const uint32_t even = word & LANES_EVEN;
+    const uint32_t odd = (word >> 8) & LANES_EVEN;
+    return (((even * factor) >> 8) & LANES_EVEN) | ((odd * factor) & LANES_ODD);
+}
+
+}
+#endif
+
+void EFLedKernels::Reference::scale(uint8_t* data, const size_t len, const uint8_t scale) {
+    const uint16_t factor = scale + 1;
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (data[i] * factor) >> 8;
+    }
+}
+
+void EFLedKernels::Reference::scaleVideo(uint8_t* data, const size_t len, const uint8_t scale) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = ((data[i] * scale) >> 8) + ((data[i] && scale) ? 1 : 0);
+    }
+}
+
+void EFLedKernels::Reference::blend(const uint8_t* a, const uint8_t* b, uint8_t* out, const size_t len, const uint8_t amount) {
+    // Same as blend8(): ((a << 8) | b) + (b - a) * amount, which never leaves 16 bit
+    const uint16_t factor_a = 256 - amount;
+    const uint16_t factor_b = 1 + amount;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (a[i] * factor_a + b[i] * factor_b) >> 8;
+    }
+}
+
+void EFLedKernels::Reference::add(uint8_t* data, const uint8_t* src, const size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        const uint16_t sum = data[i] + src[i];
+        data[i] = sum > 255 ? 255 : sum;
+    }
+}
+
+uint32_t EFLedKernels::Reference::sum16(const uint16_t* data, const size_t len) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+void EFLedKernels::scale(CRGB* leds, const size_t num, const uint8_t scale) {
+    uint8_t* data = reinterpret_cast<uint8_t*>(leds);
+    size_t len = num * sizeof(CRGB);
+
+#if EFLED_KERNELS_SWAR
+    if (isAligned(data)) {
+        const uint32_t factor = scale + 1;
+        for (; len >= 4; len -= 4, data += 4) {
+            store(data, mulhi(load(data), factor));
+        }
+    }
+#endif
+
+    Reference::scale(data, len, scale);
+}
+
+void EFLedKernels::scaleVideo(CRGB* leds, const size_t num, const uint8_t scale) {
+    uint8_t* data = reinterpret_cast<uint8_t*>(leds);
+    size_t len = num * sizeof(CRGB);
+
+#if EFLED_KERNELS_SWAR
+    if (isAligned(data) && scale > 0) {
+        for (; len >= 4; len -= 4, data += 4) {
+            const uint32_t word = load(data);
+            // Every lit channel gets +1. Scaled channels are at most 254, so this never carries.
+            const uint32_t lit = ((((word & LOW7) + LOW7) | word) & HIGH1) >> 7;
+            store(data, mulhi(word, scale) + lit);
+        }
+    }
+#endif
+
+    Reference::scaleVideo(data, len, scale);
+}
+
+void EFLedKernels::fadeLightBy(CRGB* leds, const size_t num, const uint8_t fade) {
+    scaleVideo(leds, num, 255 - fade);
+}
+
+void EFLedKernels::fadeToBlackBy(CRGB* leds, const size_t num, const uint8_t fade) {
+    scale(leds, num, 255 - fade);
+}
+
+void EFLedKernels::blend(const CRGB* a, const CRGB* b, CRGB* out, const size_t num, const uint8_t amount) {
+    const uint8_t* data_a = reinterpret_cast<const uint8_t*>(a);
+    const uint8_t* data_b = reinterpret_cast<const uint8_t*>(b);
+    uint8_t* data_out = reinterpret_cast<uint8_t*>(out);
+    size_t len = num * sizeof(CRGB);
+
+#if EFLED_KERNELS_SWAR
+    if (isAligned(data_a) && isAligned(data_b) && isAligned(data_out)) {
+        // Both 16-bit lane products sum up to at most 255 * 257, so lanes never overflow
+        const uint32_t factor_a = 256 - amount;
+        const uint32_t factor_b = 1 + amount;
+        for (; len >= 4; len -= 4, data_a += 4, data_b += 4, data_out += 4) {
+            const uint32_t word_a = load(data_a);
+            const uint32_t word_b = load(data_b);
+            const uint32_t even = (word_a & LANES_EVEN) * factor_a + (word_b & LANES_EVEN) * factor_b;
+            const uint32_t odd = ((word_a >> 8) & LANES_EVEN) * factor_a + ((word_b >> 8) & LANES_EVEN) * factor_b;
+            store(data_out, ((even >> 8) & LANES_EVEN) | (odd & LANES_ODD));
+        }
+    }
+#endif
+
+    Reference::blend(data_a, data_b, data_out, len, amount);
+}
+
+void EFLedKernels::add(CRGB* leds, const CRGB* src, const size_t num) {
+    uint8_t* data = reinterpret_cast<uint8_t*>(leds);
+    const uint8_t* data_src = reinterpret_cast<const uint8_t*>(src);
+    size_t len = num * sizeof(CRGB);
+
+#if EFLED_KERNELS_SWAR
+    if (isAligned(data) && isAligned(data_src)) {
+        for (; len >= 4; len -= 4, data += 4, data_src += 4) {
+            const uint32_t a = load(data);
+            const uint32_t b = load(data_src);
+            // Add lower 7 bits of all channels, then fix up the top bits and saturate channels that carried out
+            const uint32_t sum = ((a & LOW7) + (b & LOW7)) ^ ((a ^ b) & HIGH1);
+            const uint32_t carry = ((a & b) | ((a | b) & ~sum)) & HIGH1;
+            store(data, sum | ((carry >> 7) * 0xFF));
+        }
+    }
+#endif
+
+    Reference::add(data, data_src, len);
+}
+
+void EFLedKernels::blendAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        if (alpha[i] > 0) {
+            nblend(leds[i], src[i], alpha[i]);
+        }
+    }
+}
+
+void EFLedKernels::addAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        if (alpha[i] > 0) {
+            leds[i] += src[i].scale8(alpha[i]);
+        }
+    }
+}
+
+void EFLedKernels::multiplyAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        if (alpha[i] > 0) {
+            for (uint8_t c = 0; c < 3; c++) {
+                leds[i].raw[c] = scale8(leds[i].raw[c], blend8(255, src[i].raw[c], alpha[i]));
+            }
+        }
+    }
+}
+
+void EFLedKernels::scale16(const uint16_t* data, uint16_t* out, const size_t len, const uint16_t scale) {
+    // Each product needs the full 32 bits, so there is no room for SWAR lanes
+    for (size_t i = 0; i < len; i++) {
+        out[i] = ((uint32_t) data[i] * scale) >> 16;
+    }
+}
+
+uint32_t EFLedKernels::sum16(const uint16_t* data, const size_t len) {
+    size_t remaining = len;
+    uint32_t sum = 0;
+
+#if EFLED_KERNELS_SWAR
+    if (isAligned(data)) {
+        uint32_t even = 0;
+        uint32_t odd = 0;
+        for (; remaining >= 2; remaining -= 2, data += 2) {
+            const uint32_t word = load(reinterpret_cast<const uint8_t*>(data));
+            even += word & 0xFFFF;
+            odd += word >> 16;
+        }
+        sum = even + odd;
+    }
+#endif
+
+    return sum + Reference::sum16(data, remaining);
+}
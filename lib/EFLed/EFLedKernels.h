@@ -0,0 +1,183 @@
+#ifndef EFLEDKERNELS_H_
+#define EFLEDKERNELS_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FastLED.h>
+
+/**
+ * @brief Use 32-bit SIMD within a register (SWAR) for the uniform kernels.
+ * Set to 0 to always use the scalar reference implementation.
+ */
+#ifndef EFLED_KERNELS_SWAR
+#define EFLED_KERNELS_SWAR 1
+#endif
+
+/**
+ * @brief Per-frame color kernels operating on whole LED arrays. Results are
+ * bit-exact to the FastLED functions of the same name.
+ *
+ * Uniform kernels process four color channels per 32-bit operation, if all
+ * given arrays are 4-byte aligned (declare buffers using `alignas(4)`).
+ * Unaligned arrays fall back to the scalar reference implementation, since the
+ * Xtensa core does not support unaligned word access.
+ */
+class EFLedKernels {
+
+    public:
+
+        /**
+         * @brief Same as FastLEDs nscale8(): Scales all colors by scale / 256
+         *
+         * @param leds LEDs to modify
+         * @param num Number of LEDs
+         * @param scale Scale factor (0-255)
+         */
+        static void scale(CRGB* leds, const size_t num, const uint8_t scale);
+
+        /**
+         * @brief Same as FastLEDs nscale8_video(): Scales all colors but never
+         * dims a lit channel to zero
+         *
+         * @param leds LEDs to modify
+         * @param num Number of LEDs
+         * @param scale Scale factor (0-255)
+         */
+        static void scaleVideo(CRGB* leds, const size_t num, const uint8_t scale);
+
+        /**
+         * @brief Same as FastLEDs fadeLightBy()
+         *
+         * @param leds LEDs to modify
+         * @param num Number of LEDs
+         * @param fade Amount to fade (0: unchanged, 255: almost dark)
+         */
+        static void fadeLightBy(CRGB* leds, const size_t num, const uint8_t fade);
+
+        /**
+         * @brief Same as FastLEDs fadeToBlackBy()
+         *
+         * @param leds LEDs to modify
+         * @param num Number of LEDs
+         * @param fade Amount to fade (0: unchanged, 255: dark)
+         */
+        static void fadeToBlackBy(CRGB* leds, const size_t num, const uint8_t fade);
+
+        /**
+         * @brief Same as FastLEDs blend() for LED arrays. The output may alias
+         * either input.
+         *
+         * @param a First input
+         * @param b Second input
+         * @param out Output
+         * @param num Number of LEDs
+         * @param amount Amount of b (0: only a, 255: only b)
+         */
+        static void blend(const CRGB* a, const CRGB* b, CRGB* out, const size_t num, const uint8_t amount);
+
+        /**
+         * @brief Adds src to leds, saturating each channel at 255
+         *
+         * @param leds LEDs to modify
+         * @param src Colors to add
+         * @param num Number of LEDs
+         */
+        static void add(CRGB* leds, const CRGB* src, const size_t num);
+
+        /**
+         * @brief Blends src over leds with a separate alpha per LED
+         *
+         * @param leds LEDs to modify
+         * @param src Colors to blend in
+         * @param alpha Opacity of each LED in src
+         * @param num Number of LEDs
+         */
+        static void blendAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num);
+
+        /**
+         * @brief Adds src scaled by a separate alpha per LED to leds, saturating at 255
+         *
+         * @param leds LEDs to modify
+         * @param src Colors to add
+         * @param alpha Opacity of each LED in src
+         * @param num Number of LEDs
+         */
+        static void addAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num);
+
+        /**
+         * @brief Multiplies leds with src, weighted by a separate alpha per LED
+         *
+         * @param leds LEDs to modify
+         * @param src Colors to multiply with
+         * @param alpha Opacity of each LED in src
+         * @param num Number of LEDs
+         */
+        static void multiplyAlpha(CRGB* leds, const CRGB* src, const uint8_t* alpha, const size_t num);
+
+        /**
+         * @brief Scales 16-bit linear channels by scale / 65536. Used to apply
+         * the brightness to the linear framebuffer. The output may alias the input.
+         *
+         * @param data Linear channels
+         * @param out Output
+         * @param len Number of channels
+         * @param scale Scale factor (0-65535)
+         */
+        static void scale16(const uint16_t* data, uint16_t* out, const size_t len, const uint16_t scale);
+
+        /**
+         * @brief Sums up 16-bit linear channels. Used to estimate the current of
+         * a frame. Reads two channels per 32-bit operation, if data is 4-byte aligned.
+         *
+         * @param data Linear channels
+         * @param len Number of channels, at most 65536
+         * @return Sum of all channels
+         */
+        static uint32_t sum16(const uint16_t* data, const size_t len);
+
+        /**
+         * @brief Scalar implementations of the uniform kernels. Used for
+         * unaligned arrays and to verify the SWAR implementations.
+         */
+        class Reference {
+
+            public:
+                static void scale(uint8_t* data, const size_t len, const uint8_t scale);
+                static void scaleVideo(uint8_t* data, const size_t len, const uint8_t scale);
+                static void blend(const uint8_t* a, const uint8_t* b, uint8_t* out, const size_t len, const uint8_t amount);
+                static void add(uint8_t* data, const uint8_t* src, const size_t len);
+                static uint32_t sum16(const uint16_t* data, const size_t len);
+
+        };
+
+};
+
+#endif /* EFLEDKERNELS_H_ */
@@ -0,0 +1,66 @@
+#ifndef EFLEDLAYER_H_
+#define EFLEDLAYER_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief Number of overlay layers composited above the base layer
+ */
+#define EFLED_OVERLAY_NUM 3
+
+/**
+ * @brief Overlay layers, from bottom to top
+ */
+#define EFLED_OVERLAY_UI 0      //!< Short-lived user feedback, e.g., the lock indicator
+#define EFLED_OVERLAY_STATUS 1  //!< Long-running status displays, e.g., the OTA progress bar
+#define EFLED_OVERLAY_SYSTEM 2  //!< Critical system indicators, e.g., the brown-out warning
+
+/**
+ * @brief Determines how an overlay pixel is combined with the pixel below it
+ */
+enum class EFLedBlendMode {
+    Normal,   //!< Overlay color replaces the color below, weighted by alpha
+    Add,      //!< Overlay color is added to the color below, weighted by alpha
+    Multiply  //!< Color below is multiplied with the overlay color, weighted by alpha
+};
+
+/**
+ * @brief Overlay layer with per-pixel alpha
+ */
+struct EFLedLayer {
+    CRGB color[EFLED_TOTAL_NUM];     //!< Color of each pixel
+    uint8_t alpha[EFLED_TOTAL_NUM];  //!< Opacity of each pixel (0: transparent, 255: opaque)
+    EFLedBlendMode mode;             //!< Blend mode of all pixels of this layer
+    bool active;                     //!< True, if at least one pixel might be non-transparent
+};
+
+#endif /* EFLEDLAYER_H_ */
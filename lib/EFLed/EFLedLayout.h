@@ -0,0 +1,51 @@
+#ifndef EFLEDLAYOUT_H_
+#define EFLEDLAYOUT_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+/**
+ * @brief Number and indices of the LEDs on the badge. Kept separate from
+ * EFLed.h, so that hardware independent parts of the LED engine do not depend
+ * on the ESP32.
+ */
+
+#define EFLED_TOTAL_NUM 17
+#define EFLED_DRAGON_NUM 6
+#define EFLED_EFBAR_NUM 11
+
+#define EFLED_DARGON_OFFSET 0
+#define EFLED_EFBAR_OFFSET 6
+
+#define EFLED_DRAGON_NOSE_IDX 0
+#define EFLED_DRAGON_MUZZLE_IDX 1
+#define EFLED_DRAGON_EYE_IDX 2
+#define EFLED_DRAGON_CHEEK_IDX 3
+#define EFLED_DRAGON_EAR_BOTTOM_IDX 4
+#define EFLED_DRAGON_EAR_TOP_IDX 5
+
+#endif /* EFLEDLAYOUT_H_ */
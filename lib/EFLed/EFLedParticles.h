@@ -0,0 +1,180 @@
+#ifndef EFLEDPARTICLES_H_
+#define EFLEDPARTICLES_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+#include "EFLedPaths.h"
+
+/**
+ * @brief Fixed-capacity particle system. Particles move along EFLedPaths and
+ * leave a fading trail. All state is kept inside the object, so instances can
+ * live in static storage and never touch the heap.
+ *
+ * Each update fades the intensity of all LEDs, moves all particles and stamps
+ * them onto the LEDs. A particle between two LEDs lights both proportionally.
+ *
+ * @tparam N Maximum number of simultaneously alive particles
+ */
+template<size_t N>
+class EFLedParticles {
+
+    public:
+
+        /**
+         * @brief A single particle
+         */
+        struct Particle {
+            uint16_t pos;       //!< Position along the path in 1/256 LEDs
+            uint16_t velocity;  //!< Distance moved per update in 1/256 LEDs
+            uint8_t value;      //!< Current brightness
+            uint8_t decay;      //!< Brightness lost per update
+            uint8_t path;       //!< Index of the path the particle moves along
+            bool alive;
+        };
+
+        /**
+         * @brief Constructs a new particle system
+         *
+         * @param paths Paths particles can move along. Must stay valid.
+         * @param paths_num Number of paths
+         */
+        constexpr EFLedParticles(const EFLedPath* paths, const uint8_t paths_num)
+        : particles{}
+        , intensity{}
+        , paths(paths)
+        , paths_num(paths_num) {}
+
+        /**
+         * @brief Removes all particles and clears all trails
+         */
+        void clear() {
+            for (Particle& p : this->particles) {
+                p.alive = false;
+            }
+            for (uint8_t& v : this->intensity) {
+                v = 0;
+            }
+        }
+
+        /**
+         * @brief Spawns a new particle at the start of a path
+         *
+         * @param path Index of the path to move along
+         * @param velocity Distance moved per update in 1/256 LEDs
+         * @param value Initial brightness
+         * @param decay Brightness lost per update
+         * @return True, if the particle was spawned. False, if all particles are in use.
+         */
+        bool spawn(const uint8_t path, const uint16_t velocity, const uint8_t value, const uint8_t decay) {
+            if (path >= this->paths_num) {
+                return false;
+            }
+
+            for (Particle& p : this->particles) {
+                if (!p.alive) {
+                    p = {0, velocity, value, decay, path, true};
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Advances the simulation by one step
+         *
+         * @param trail Factor all LEDs are scaled by before the particles are
+         * drawn (0-255). Higher values result in longer trails.
+         */
+        void update(const uint8_t trail) {
+            for (uint8_t& v : this->intensity) {
+                v = scale8(v, trail);
+            }
+
+            for (Particle& p : this->particles) {
+                if (!p.alive) {
+                    continue;
+                }
+
+                const EFLedPath& path = this->paths[p.path];
+                const uint8_t idx = p.pos >> 8;
+                const uint8_t frac = p.pos & 0xFF;
+                this->_stamp(path.leds[idx], scale8(p.value, 255 - frac));
+                if (idx + 1 < path.num) {
+                    this->_stamp(path.leds[idx + 1], scale8(p.value, frac));
+                }
+
+                p.pos += p.velocity;
+                p.value = qsub8(p.value, p.decay);
+                p.alive = p.value > 0 && (p.pos >> 8) < path.num;
+            }
+        }
+
+        /**
+         * @brief Retrieves the current intensity of an LED
+         *
+         * @param idx Number of the LED
+         * @return Intensity (0-255)
+         */
+        uint8_t getIntensity(const uint8_t idx) const {
+            return this->intensity[idx];
+        }
+
+        /**
+         * @brief Retrieves the number of alive particles
+         */
+        size_t count() const {
+            size_t num = 0;
+            for (const Particle& p : this->particles) {
+                num += p.alive;
+            }
+            return num;
+        }
+
+        constexpr size_t capacity() const {
+            return N;
+        }
+
+    protected:
+
+        Particle particles[N];
+        uint8_t intensity[EFLED_TOTAL_NUM];
+        const EFLedPath* paths;
+        const uint8_t paths_num;
+
+        void _stamp(const uint8_t led, const uint8_t value) {
+            this->intensity[led] = value > this->intensity[led] ? value : this->intensity[led];
+        }
+};
+
+#endif /* EFLEDPARTICLES_H_ */
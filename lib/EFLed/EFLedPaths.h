@@ -0,0 +1,124 @@
+#ifndef EFLEDPATHS_H_
+#define EFLEDPATHS_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+
+#include "EFLedLayout.h"
+#include "EFLedGeometry.h"
+
+/**
+ * @brief Ordered sequence of LEDs along which something can move
+ */
+struct EFLedPath {
+    const uint8_t* leds;
+    uint8_t num;
+};
+
+/**
+ * @brief Predefined paths across the badge
+ */
+class EFLedPaths {
+
+    public:
+
+        /**
+         * @brief Dragon LEDs from the top ear down to the nose
+         */
+        static constexpr uint8_t dragon_down[EFLED_DRAGON_NUM] = {
+            EFLED_DRAGON_EAR_TOP_IDX,
+            EFLED_DRAGON_EAR_BOTTOM_IDX,
+            EFLED_DRAGON_CHEEK_IDX,
+            EFLED_DRAGON_EYE_IDX,
+            EFLED_DRAGON_MUZZLE_IDX,
+            EFLED_DRAGON_NOSE_IDX,
+        };
+
+        /**
+         * @brief EF bar LEDs from top to bottom
+         */
+        static constexpr uint8_t efbar_down[EFLED_EFBAR_NUM] = {
+            EFLED_EFBAR_OFFSET + 0,
+            EFLED_EFBAR_OFFSET + 1,
+            EFLED_EFBAR_OFFSET + 2,
+            EFLED_EFBAR_OFFSET + 3,
+            EFLED_EFBAR_OFFSET + 4,
+            EFLED_EFBAR_OFFSET + 5,
+            EFLED_EFBAR_OFFSET + 6,
+            EFLED_EFBAR_OFFSET + 7,
+            EFLED_EFBAR_OFFSET + 8,
+            EFLED_EFBAR_OFFSET + 9,
+            EFLED_EFBAR_OFFSET + 10,
+        };
+
+        /**
+         * @brief Dragon LEDs around the outline of the head, starting at the nose
+         */
+        static constexpr uint8_t dragon_outline[EFLED_DRAGON_NUM] = {
+            EFLED_DRAGON_NOSE_IDX,
+            EFLED_DRAGON_MUZZLE_IDX,
+            EFLED_DRAGON_EYE_IDX,
+            EFLED_DRAGON_EAR_TOP_IDX,
+            EFLED_DRAGON_EAR_BOTTOM_IDX,
+            EFLED_DRAGON_CHEEK_IDX,
+        };
+
+        /**
+         * @brief All LEDs in order of their numbers: From the dragon nose up to
+         * its ear, then down the EF bar
+         */
+        static constexpr uint8_t all[EFLED_TOTAL_NUM] = {
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+        };
+
+        /**
+         * @brief All paths leading from the top to the bottom of the badge
+         */
+        static constexpr EFLedPath falling[] = {
+            {dragon_down, EFLED_DRAGON_NUM},
+            {efbar_down, EFLED_EFBAR_NUM},
+        };
+
+        /**
+         * @brief Checks whether all LEDs of the path are ordered from top to bottom
+         */
+        static constexpr bool isFalling(const uint8_t* leds, const uint8_t num) {
+            for (uint8_t i = 1; i < num; i++) {
+                if (EFLedGeometry::positions[leds[i]].y <= EFLedGeometry::positions[leds[i - 1]].y) {
+                    return false;
+                }
+            }
+            return true;
+        }
+};
+
+static_assert(EFLedPaths::isFalling(EFLedPaths::dragon_down, EFLED_DRAGON_NUM), "Dragon path must lead downwards");
+static_assert(EFLedPaths::isFalling(EFLedPaths::efbar_down, EFLED_EFBAR_NUM), "EF bar path must lead downwards");
+
+#endif /* EFLEDPATHS_H_ */
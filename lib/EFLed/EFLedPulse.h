@@ -0,0 +1,146 @@
+#ifndef EFLEDPULSE_H_
+#define EFLEDPULSE_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "EFLedGeometry.h"
+#include "EFLedLayout.h"
+
+/**
+ * @brief Intensity of a single beat over one period (256 samples). Waveforms
+ * are built by the compiler and sampled using integer math only.
+ */
+struct EFLedWaveform {
+    uint8_t v[256];
+
+    /**
+     * @brief Builds a single positive sine half-wave, followed by a pause of the same length
+     */
+    static constexpr EFLedWaveform sine() {
+        constexpr double pi = 3.14159265358979323846;
+        EFLedWaveform w = {};
+        for (uint16_t i = 0; i < 128; i++) {
+            w.v[i] = static_cast<uint8_t>(EFLedGeometry::sin(pi * i / 128.0) * 255.0 + 0.5);
+        }
+        return w;
+    }
+
+    /**
+     * @brief Builds a "lub-dub" double beat: A strong beat, directly followed by a
+     * weaker one, and a longer pause
+     */
+    static constexpr EFLedWaveform lubDub() {
+        constexpr double pi = 3.14159265358979323846;
+        constexpr struct {
+            uint16_t start;
+            uint16_t length;
+            double amplitude;
+        } beats[2] = {
+            {0, 56, 1.0},
+            {64, 48, 0.6},
+        };
+
+        EFLedWaveform w = {};
+        for (const auto& beat : beats) {
+            for (uint16_t i = 0; i < beat.length; i++) {
+                const double s = EFLedGeometry::sin(pi * i / beat.length);
+                w.v[beat.start + i] = static_cast<uint8_t>(s * s * beat.amplitude * 255.0 + 0.5);
+            }
+        }
+        return w;
+    }
+
+    /**
+     * @brief Samples the waveform with linear interpolation between two samples
+     *
+     * @param phase Phase within the beat (0-65535)
+     * @return Intensity (0-255)
+     */
+    uint8_t sample(const uint16_t phase) const {
+        const uint8_t a = this->v[phase >> 8];
+        const uint8_t b = this->v[((phase >> 8) + 1) & 0xFF];
+        return a + (((int16_t) b - a) * (phase & 0xFF) >> 8);
+    }
+};
+
+/**
+ * @brief Pulses spreading from origin LEDs across the badge. LEDs further away
+ * from an origin lag behind. Stores the phase lag of each LED behind each
+ * origin, so rendering a frame only needs table lookups.
+ *
+ * @tparam N Number of origins
+ */
+template<size_t N>
+struct EFLedPulse {
+    uint16_t offsets[N][EFLED_TOTAL_NUM];  //!< Phase lag of each LED behind each origin. One beat is 65536.
+
+    /**
+     * @brief Builds the phase offsets. Evaluated by the compiler.
+     *
+     * @param origins LEDs the pulses originate from
+     * @param wavelength_mm Distance covered by a pulse during one beat
+     */
+    static constexpr EFLedPulse build(const uint8_t (&origins)[N], const uint16_t wavelength_mm) {
+        EFLedPulse p = {};
+        for (size_t o = 0; o < N; o++) {
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                p.offsets[o][i] = static_cast<uint16_t>(
+                    (uint32_t) EFLedGeometry::pairwise[origins[o]][i] * 65536
+                    / ((uint32_t) wavelength_mm << EFLED_GEOMETRY_DIST_SHIFT)
+                );
+            }
+        }
+        return p;
+    }
+
+    /**
+     * @brief Renders the intensity of all LEDs. Overlapping pulses use the brightest one.
+     *
+     * @param wave Waveform of a single beat
+     * @param mask Bitmask of active origins (bit n: origin n)
+     * @param phase Phase of the beat at the origins (0-65535)
+     * @param values Array of EFLED_TOTAL_NUM intensities to write
+     */
+    void render(const EFLedWaveform& wave, const uint8_t mask, const uint16_t phase, uint8_t* values) const {
+        for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+            uint8_t value = 0;
+            for (size_t o = 0; o < N; o++) {
+                if (mask & (1 << o)) {
+                    const uint8_t v = wave.sample(phase - this->offsets[o][i]);
+                    value = v > value ? v : value;
+                }
+            }
+            values[i] = value;
+        }
+    }
+};
+
+#endif /* EFLEDPULSE_H_ */
@@ -0,0 +1,170 @@
+#ifndef EFLEDSNAKES_H_
+#define EFLEDSNAKES_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+#include "EFLedPaths.h"
+
+/**
+ * @brief Fixed-capacity set of snakes endlessly circling along EFLedPaths.
+ * Snakes are rendered purely by index arithmetic from their head position,
+ * so no per-LED state and no heap is required.
+ *
+ * Positions are kept in 1/256 LEDs. The head of a snake between two LEDs
+ * partially lights the next LED, so that slow snakes move smoothly.
+ *
+ * @tparam N Maximum number of snakes
+ */
+template<size_t N>
+class EFLedSnakes {
+
+    public:
+
+        /**
+         * @brief A single snake
+         */
+        struct Snake {
+            uint16_t pos;       //!< Position of the head along the path in 1/256 LEDs
+            uint16_t velocity;  //!< Distance moved per update in 1/256 LEDs
+            uint8_t length;     //!< Length in LEDs
+            uint8_t path;       //!< Index of the path the snake moves along
+            CRGB color;         //!< Color of the head
+            bool fade;          //!< If true, the tail fades out towards its end
+            bool alive;
+        };
+
+        /**
+         * @brief Constructs a new set of snakes
+         *
+         * @param paths Paths snakes can move along. Must stay valid.
+         * @param paths_num Number of paths
+         */
+        constexpr EFLedSnakes(const EFLedPath* paths, const uint8_t paths_num)
+        : snakes{}
+        , paths(paths)
+        , paths_num(paths_num) {}
+
+        /**
+         * @brief Removes all snakes
+         */
+        void clear() {
+            for (Snake& s : this->snakes) {
+                s.alive = false;
+            }
+        }
+
+        /**
+         * @brief Adds a new snake with its head at the start of a path
+         *
+         * @param path Index of the path to move along
+         * @param velocity Distance moved per update in 1/256 LEDs
+         * @param length Length in LEDs (1 - number of LEDs in path)
+         * @param color Color of the snake
+         * @param fade If true, the tail fades out towards its end
+         * @return True, if the snake was added. False, if all snakes are in use.
+         */
+        bool add(const uint8_t path, const uint16_t velocity, const uint8_t length, const CRGB color, const bool fade) {
+            if (path >= this->paths_num || length == 0) {
+                return false;
+            }
+
+            for (Snake& s : this->snakes) {
+                if (!s.alive) {
+                    s = {0, velocity, length, path, color, fade, true};
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Moves all snakes by their velocity
+         */
+        void update() {
+            for (Snake& s : this->snakes) {
+                if (s.alive) {
+                    s.pos = (s.pos + s.velocity) % (this->paths[s.path].num << 8);
+                }
+            }
+        }
+
+        /**
+         * @brief Draws all snakes. Overlapping snakes are combined using the
+         * brightest value of each color channel.
+         *
+         * @param leds Array of EFLED_TOTAL_NUM colors to draw onto
+         */
+        void render(CRGB* leds) const {
+            for (const Snake& s : this->snakes) {
+                if (!s.alive) {
+                    continue;
+                }
+
+                const EFLedPath& path = this->paths[s.path];
+                const int32_t total = path.num << 8;
+                const int32_t length = s.length << 8;
+                for (uint8_t i = 0; i < path.num; i++) {
+                    // Distance of this LED behind the head, -256 being one LED ahead of it
+                    const int32_t distance = (s.pos - (i << 8) + 256 + total) % total - 256;
+
+                    int32_t value;
+                    if (distance < 0) {
+                        value = 256 + distance;
+                    } else if (distance >= length) {
+                        continue;
+                    } else if (s.fade) {
+                        value = (length - distance) * 256 / length;
+                    } else {
+                        value = distance < length - 256 ? 256 : length - distance;
+                    }
+
+                    if (value > 0) {
+                        leds[path.leds[i]] |= s.color.scale8(value > 255 ? 255 : value);
+                    }
+                }
+            }
+        }
+
+        constexpr size_t capacity() const {
+            return N;
+        }
+
+    protected:
+
+        Snake snakes[N];
+        const EFLedPath* paths;
+        const uint8_t paths_num;
+};
+
+#endif /* EFLEDSNAKES_H_ */
@@ -0,0 +1,73 @@
+#ifndef EFLEDSTATS_H_
+#define EFLEDSTATS_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+
+#include <stdint.h>
+
+/**
+ * @brief Number of histogram buckets. Bucket i counts durations between 2^i and
+ * 2^(i+1)-1 microseconds, the last bucket also counts all longer durations.
+ */
+#define EFLED_STATS_HIST_NUM 20
+
+/**
+ * @brief Default expected interval between two shows in microseconds. Matches
+ * the default render clock of 100 Hz.
+ */
+#define EFLED_STATS_FRAME_US_DEFAULT 10000
+
+/**
+ * @brief Intervals longer than this are considered idle time (e.g., static LEDs)
+ * instead of late frames
+ */
+#define EFLED_STATS_IDLE_US 1000000
+
+/**
+ * @brief Timing statistics of the LED output, collected if EFLED_ENABLE_STATS is
+ * defined. Durations of FastLED.show() are measured in CPU cycles, intervals
+ * between two shows in microseconds.
+ */
+struct EFLedStats {
+    uint32_t shows;                 //!< Number of FastLED.show() calls
+    uint32_t shows_per_second;      //!< Average shows per second over the last window of at least one second
+    uint32_t show_cycles_last;      //!< CPU cycles of the last show
+    uint32_t show_cycles_min;       //!< Minimum CPU cycles of a single show
+    uint32_t show_cycles_max;       //!< Maximum CPU cycles of a single show
+    uint64_t show_cycles_total;     //!< CPU cycles of all shows
+    uint32_t interval_us_last;      //!< Microseconds between the last two shows
+    uint32_t interval_us_min;       //!< Minimum microseconds between two shows
+    uint32_t interval_us_max;       //!< Maximum microseconds between two shows, excluding idle time
+    uint32_t late;                  //!< Number of shows that started more than half a frame interval after their expected time
+    uint32_t blocked;               //!< Number of presented frames that had to wait for the previous transmission
+    uint32_t show_hist[EFLED_STATS_HIST_NUM];      //!< Histogram of show durations in microseconds
+    uint32_t interval_hist[EFLED_STATS_HIST_NUM];  //!< Histogram of intervals between shows in microseconds
+};
+
+#endif /* EFLEDSTATS_H_ */
@@ -0,0 +1,221 @@
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+#include "EFLed.h"
+#include "EFLedBar.h"
+#include "EFLedTimeline.h"
+
+EFLedTimeline::EFLedTimeline()
+: num_keyframes(0)
+, region(EFLED_MASK_NONE)
+, background(CRGB::Black)
+, background_alpha(0)
+, started_ms(0)
+, running(false)
+{
+}
+
+void EFLedTimeline::reset(const uint32_t region, const CRGB background, const uint8_t background_alpha) {
+    this->num_keyframes = 0;
+    this->region = region & EFLED_MASK_ALL;
+    this->background = background;
+    this->background_alpha = background_alpha;
+    this->running = false;
+}
+
+bool EFLedTimeline::add(
+    const uint16_t duration_ms,
+    const uint32_t mask,
+    const CRGB color,
+    const uint8_t brightness,
+    const bool fade
+) {
+    if (this->num_keyframes >= EFLED_TIMELINE_MAX_KEYFRAMES) {
+        return false;
+    }
+
+    this->keyframes[this->num_keyframes++] = {
+        .duration_ms = duration_ms,
+        .mask = mask & this->region,
+        .color = color,
+        .brightness = brightness,
+        .level = EFLED_KEYFRAME_NO_LEVEL,
+        .fade = fade,
+        .frames = nullptr,
+        .frame_ms = 0
+    };
+    return true;
+}
+
+bool EFLedTimeline::addLevel(
+    const uint16_t duration_ms,
+    const uint16_t level,
+    const CRGB color,
+    const uint8_t brightness,
+    const bool fade
+) {
+    if (this->num_keyframes >= EFLED_TIMELINE_MAX_KEYFRAMES) {
+        return false;
+    }
+
+    this->keyframes[this->num_keyframes++] = {
+        .duration_ms = duration_ms,
+        .mask = EFLED_MASK_NONE,
+        .color = color,
+        .brightness = brightness,
+        .level = min(level, (uint16_t) EFLEDBAR_LEVEL_MAX),
+        .fade = fade,
+        .frames = nullptr,
+        .frame_ms = 0
+    };
+    return true;
+}
+
+bool EFLedTimeline::addFrames(
+    const CRGB* frames,
+    const uint16_t num_frames,
+    const uint16_t frame_ms,
+    const uint8_t brightness
+) {
+    const uint32_t duration_ms = (uint32_t) num_frames * frame_ms;
+    if (this->num_keyframes >= EFLED_TIMELINE_MAX_KEYFRAMES || duration_ms == 0 || duration_ms > UINT16_MAX) {
+        return false;
+    }
+
+    this->keyframes[this->num_keyframes++] = {
+        .duration_ms = (uint16_t) duration_ms,
+        .mask = this->region,
+        .color = CRGB::Black,
+        .brightness = brightness,
+        .level = EFLED_KEYFRAME_NO_LEVEL,
+        .fade = false,
+        .frames = frames,
+        .frame_ms = frame_ms
+    };
+    return true;
+}
+
+void EFLedTimeline::start(const unsigned long now_ms) {
+    this->started_ms = now_ms;
+    this->running = this->num_keyframes > 0;
+}
+
+void EFLedTimeline::stop() {
+    this->running = false;
+}
+
+bool EFLedTimeline::isRunning() const {
+    return this->running;
+}
+
+uint32_t EFLedTimeline::getRegion() const {
+    return this->region;
+}
+
+bool EFLedTimeline::render(const unsigned long now_ms, EFLedLayer& layer, uint8_t& brightness) {
+    brightness = EFLED_KEYFRAME_KEEP_BRIGHTNESS;
+    if (!this->running) {
+        return false;
+    }
+
+    // Find the keyframe active at the given time
+    unsigned long elapsed = now_ms - this->started_ms;
+    uint8_t idx = 0;
+    while (idx < this->num_keyframes && elapsed >= this->keyframes[idx].duration_ms) {
+        elapsed -= this->keyframes[idx].duration_ms;
+        idx++;
+    }
+    if (idx >= this->num_keyframes) {
+        this->running = false;
+        return false;
+    }
+
+    // Keyframes with a duration of 0 are applied together with the active one
+    uint8_t first = idx;
+    while (first > 0 && this->keyframes[first - 1].duration_ms == 0) {
+        first--;
+    }
+
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        if (this->region & EFLED_MASK(i)) {
+            layer.color[i] = this->background;
+            layer.alpha[i] = this->background_alpha;
+        }
+    }
+
+    for (uint8_t k = first; k <= idx; k++) {
+        const EFLedKeyframe& keyframe = this->keyframes[k];
+        CRGB color = keyframe.color;
+        uint16_t level = keyframe.level;
+        brightness = keyframe.brightness != EFLED_KEYFRAME_KEEP_BRIGHTNESS ? keyframe.brightness : brightness;
+
+        // Interpolate towards the next keyframe. Keyframes with a duration of 0
+        // belong to the keyframe after them and are skipped.
+        uint8_t n = idx + 1;
+        while (k == idx && keyframe.fade && n + 1 < this->num_keyframes && this->keyframes[n].duration_ms == 0) {
+            n++;
+        }
+        if (k == idx && keyframe.fade && n < this->num_keyframes) {
+            const EFLedKeyframe& next = this->keyframes[n];
+            const fract8 progress = elapsed * 255 / keyframe.duration_ms;
+            color = blend(keyframe.color, next.color, progress);
+            if (keyframe.brightness != EFLED_KEYFRAME_KEEP_BRIGHTNESS && next.brightness != EFLED_KEYFRAME_KEEP_BRIGHTNESS) {
+                brightness = lerp8by8(keyframe.brightness, next.brightness, progress);
+            }
+            if (keyframe.level != EFLED_KEYFRAME_NO_LEVEL && next.level != EFLED_KEYFRAME_NO_LEVEL) {
+                level = keyframe.level + ((int32_t) next.level - keyframe.level) * (int32_t) elapsed / keyframe.duration_ms;
+            }
+        }
+
+        // Pre-rendered frames always have a duration, so only the active keyframe plays them
+        const CRGB* frame = keyframe.frames != nullptr ? keyframe.frames + (elapsed / keyframe.frame_ms) * EFLED_TOTAL_NUM : nullptr;
+
+        for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+            if (keyframe.mask & EFLED_MASK(i)) {
+                layer.color[i] = frame != nullptr ? frame[i] : color;
+                layer.alpha[i] = 255;
+            }
+        }
+
+        if (level != EFLED_KEYFRAME_NO_LEVEL) {
+            CRGB bar[EFLED_EFBAR_NUM];
+            EFLedBar::fill(bar, level, color, this->background);
+            for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+                if (this->region & EFLED_MASK(EFLED_EFBAR_OFFSET + i)) {
+                    layer.color[EFLED_EFBAR_OFFSET + i] = bar[i];
+                    layer.alpha[EFLED_EFBAR_OFFSET + i] = i * EFLEDBAR_SUBSTEPS < level ? 255 : this->background_alpha;
+                }
+            }
+        }
+    }
+
+    layer.active = true;
+    return true;
+}
@@ -0,0 +1,210 @@
+#ifndef EFLEDTIMELINE_H_
+#define EFLEDTIMELINE_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <FastLED.h>
+
+#include "EFLedLayout.h"
+
+/**
+ * @brief Maximum number of keyframes a single timeline can hold
+ */
+#define EFLED_TIMELINE_MAX_KEYFRAMES 32
+
+/**
+ * @brief Minimum number of milliseconds between two timeline updates
+ */
+#define EFLED_TIMELINE_INTERVAL_MS 10
+
+/**
+ * @brief Brightness value of a keyframe that leaves the global brightness untouched
+ */
+#define EFLED_KEYFRAME_KEEP_BRIGHTNESS 0xFF
+
+/**
+ * @brief Level value of a keyframe that does not fill the EF bar
+ */
+#define EFLED_KEYFRAME_NO_LEVEL 0xFFFF
+
+/**
+ * @brief LED masks to select LEDs for a keyframe. Bit n represents LED n.
+ */
+#define EFLED_MASK(idx) (1UL << (idx))
+#define EFLED_MASK_NONE 0UL
+#define EFLED_MASK_ALL ((1UL << EFLED_TOTAL_NUM) - 1)
+#define EFLED_MASK_DRAGON (((1UL << EFLED_DRAGON_NUM) - 1) << EFLED_DARGON_OFFSET)
+#define EFLED_MASK_EFBAR (((1UL << EFLED_EFBAR_NUM) - 1) << EFLED_EFBAR_OFFSET)
+#define EFLED_MASK_EFBAR_FILL(num) (((1UL << (num)) - 1) << EFLED_EFBAR_OFFSET)  //!< First num LEDs of the EF bar
+
+/**
+ * @brief Single step of an LED effect timeline
+ */
+struct EFLedKeyframe {
+    uint16_t duration_ms;  //!< Time until the next keyframe starts. 0 applies this keyframe together with the next one.
+    uint32_t mask;         //!< LEDs that are set to color
+    CRGB color;            //!< Color of all LEDs inside mask
+    uint8_t brightness;    //!< Global brightness in percent or EFLED_KEYFRAME_KEEP_BRIGHTNESS
+    uint16_t level;        //!< EF bar level (see EFLedBar) filled with color or EFLED_KEYFRAME_NO_LEVEL
+    bool fade;             //!< If true, color, brightness and level are interpolated towards the next keyframe with a duration
+    const CRGB* frames;    //!< Pre-rendered frames shown in order inside mask instead of color, or nullptr
+    uint16_t frame_ms;     //!< Duration of each of the pre-rendered frames
+};
+
+/**
+ * @brief Keyframed LED effect sequence, rendered into an overlay layer against the
+ * clock instead of blocking with delay()
+ */
+class EFLedTimeline {
+
+    protected:
+
+        EFLedKeyframe keyframes[EFLED_TIMELINE_MAX_KEYFRAMES];  //!< Keyframes of this timeline
+        uint8_t num_keyframes;      //!< Number of used keyframes
+        uint32_t region;            //!< LEDs affected by this timeline
+        CRGB background;            //!< Color of LEDs inside region that are not covered by the current keyframe
+        uint8_t background_alpha;   //!< Opacity of the background color
+        unsigned long started_ms;   //!< Timestamp the timeline was started at
+        bool running;               //!< True, if the timeline is currently playing
+
+    public:
+
+        /**
+         * @brief Constructs a new, empty timeline
+         */
+        EFLedTimeline();
+
+        /**
+         * @brief Stops and removes all keyframes from this timeline
+         *
+         * @param region LEDs affected by this timeline
+         * @param background Color of LEDs inside region not covered by the current keyframe
+         * @param background_alpha Opacity of the background (0: transparent, 255: opaque)
+         */
+        void reset(const uint32_t region, const CRGB background = CRGB::Black, const uint8_t background_alpha = 0);
+
+        /**
+         * @brief Appends a keyframe to this timeline
+         *
+         * @param duration_ms Time until the next keyframe starts
+         * @param mask LEDs to set to color (see EFLED_MASK*)
+         * @param color Color to set
+         * @param brightness Global brightness in percent or EFLED_KEYFRAME_KEEP_BRIGHTNESS. Only
+         * previewed while the timeline plays. Afterwards, the brightness set via
+         * EFLedClass::setBrightnessPercent() is restored.
+         * @param fade If true, interpolate towards the next keyframe
+         * @return True, if the keyframe was added. False, if the timeline is full.
+         */
+        bool add(
+            const uint16_t duration_ms,
+            const uint32_t mask,
+            const CRGB color,
+            const uint8_t brightness = EFLED_KEYFRAME_KEEP_BRIGHTNESS,
+            const bool fade = false
+        );
+
+        /**
+         * @brief Appends a keyframe that fills the EF bar up to the given level.
+         * The LED at the edge of the level is blended with the background.
+         *
+         * @param duration_ms Time until the next keyframe starts
+         * @param level Fill level between 0 and EFLEDBAR_LEVEL_MAX
+         * @param color Color of filled LEDs
+         * @param brightness Global brightness in percent or EFLED_KEYFRAME_KEEP_BRIGHTNESS,
+         * previewed like in add()
+         * @param fade If true, interpolate towards the next keyframe
+         * @return True, if the keyframe was added. False, if the timeline is full.
+         */
+        bool addLevel(
+            const uint16_t duration_ms,
+            const uint16_t level,
+            const CRGB color,
+            const uint8_t brightness = EFLED_KEYFRAME_KEEP_BRIGHTNESS,
+            const bool fade = false
+        );
+
+        /**
+         * @brief Appends a keyframe that plays pre-rendered frames on all LEDs
+         * inside region, e.g., from EFLedFrames
+         *
+         * @param frames First of num_frames consecutive frames, EFLED_TOTAL_NUM colors each.
+         * Must stay valid while the timeline plays.
+         * @param num_frames Number of frames
+         * @param frame_ms Duration of each frame
+         * @param brightness Global brightness in percent or EFLED_KEYFRAME_KEEP_BRIGHTNESS,
+         * previewed like in add()
+         * @return True, if the keyframe was added. False, if the timeline is full or
+         * the frames would last longer than UINT16_MAX milliseconds.
+         */
+        bool addFrames(
+            const CRGB* frames,
+            const uint16_t num_frames,
+            const uint16_t frame_ms,
+            const uint8_t brightness = EFLED_KEYFRAME_KEEP_BRIGHTNESS
+        );
+
+        /**
+         * @brief Starts playing this timeline from the beginning
+         *
+         * @param now_ms Current timestamp in milliseconds
+         */
+        void start(const unsigned long now_ms);
+
+        /**
+         * @brief Stops playing this timeline
+         */
+        void stop();
+
+        /**
+         * @brief Determines if this timeline is currently playing
+         *
+         * @return True, if the timeline is playing
+         */
+        bool isRunning() const;
+
+        /**
+         * @brief Renders the state of this timeline at the given time into a layer.
+         * Stops the timeline after its last keyframe ended.
+         *
+         * @param now_ms Current timestamp in milliseconds
+         * @param layer Layer to render the LEDs inside region into
+         * @param brightness Set to the brightness in percent requested by the timeline,
+         * or EFLED_KEYFRAME_KEEP_BRIGHTNESS
+         * @return True, if the timeline is still running
+         */
+        bool render(const unsigned long now_ms, EFLedLayer& layer, uint8_t& brightness);
+
+        /**
+         * @brief Retrieves the LEDs affected by this timeline
+         *
+         * @return LED mask
+         */
+        uint32_t getRegion() const;
+};
+
+#endif /* EFLEDTIMELINE_H_ */
@@ -1,195 +0,0 @@
-// MIT License
-//
-// Copyright 2024 Eurofurence e.V. 
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a
-// copy of this software and associated documentation files (the “Software”),
-// to deal in the Software without restriction, including without limitation
-// the rights to use, copy, modify, merge, publish, distribute, sublicense,
-// and/or sell copies of the Software, and to permit persons to whom the
-// Software is furnished to do so, subject to the following conditions:
-//
-// The above copyright notice and this permission notice shall be included in
-// all copies or substantial portions of the Software.
-//
-// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
-// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
-// IN THE SOFTWARE.
-
-/**
- * @author Honigeintopf
- */
-
-#include "EFPrideFlags.h"
-
-const CRGB EFPrideFlags::LGBT[] = {
-    0xFE0000,
-    0xFE0000,
-    0xFF8E01,
-    0xFF8E01,
-    0xFFEE00,
-    0x028215,
-    0x028215,
-    0x014CFF,
-    0x014CFF,
-    0x8A018C,
-    0x8A018C,
-};
-
-const CRGB EFPrideFlags::LGBTQI[] = {
-    0xFFFFFF,
-    0xFFABBA,
-    0x01CFFE,
-    0x6C3306,
-    0x080808,
-    0xFE0000,
-    0xFF8E01,
-    0xFFEE00,
-    0x028215,
-    0x014CFF,
-    0x8A018C,
-};
-
-const CRGB EFPrideFlags::Bisexual[] = {
-    0xD70071,
-    0xD70071,
-    0xD70071,
-    0xD70071,
-    0x9C4E97,
-    0x9C4E97,
-    0x9C4E97,
-    0x0035AA,
-    0x0035AA,
-    0x0035AA,
-    0x0035AA,
-};
-
-const CRGB EFPrideFlags::Polyamorous[] = {
-    0xFFFFFF,
-    0xFCBF00,
-    0x009FE3,
-    0x009FE3,
-    0x009FE3,
-    0xE50051,
-    0xE50051,
-    0xE50051,
-    0x340C46,
-    0x340C46,
-    0x340C46,
-};
-
-const CRGB EFPrideFlags::Polysexual[] = {
-    0xC84793,
-    0xC84793,
-    0xC84793,
-    0xC84793,
-    0x4BB166,
-    0x4BB166,
-    0x4BB166,
-    0x4288C8,
-    0x4288C8,
-    0x4288C8,
-    0x4288C8,
-};
-
-const CRGB EFPrideFlags::Transgender[] = {
-    0x73CFF4,
-    0x73CFF4,
-    0xE76E8E,
-    0xE76E8E,
-    0xFFFFFF,
-    0xFFFFFF,
-    0xFFFFFF,
-    0xE76E8E,
-    0xE76E8E,
-    0x73CFF4,
-    0x73CFF4,
-};
-
-const CRGB EFPrideFlags::Pansexual[] = {
-    0xE5318A,
-    0xE5318A,
-    0xE5318A,
-    0xE5318A,
-    0xFED905,
-    0xFED905,
-    0xFED905,
-    0x4AAAE0,
-    0x4AAAE0,
-    0x4AAAE0,
-    0x4AAAE0,
-};
-
-const CRGB EFPrideFlags::Asexual[] = {
-    0x080808,
-    0x080808,
-    0x080808,
-    0x605040,
-    0x605040,
-    0x605040,
-    0xFFFFFF,
-    0xFFFFFF,
-    0x7B217F,
-    0x7B217F,
-    0x7B217F,
-};
-
-const CRGB EFPrideFlags::Genderfluid[] = {
-    0xCA5982,
-    0xCA5982,
-    0xFFFFFF,
-    0xFFFFFF,
-    0x882694,
-    0x882694,
-    0x882694,
-    0x080808,
-    0x080808,
-    0x374A99,
-    0x374A99,
-};
-
-const CRGB EFPrideFlags::Genderqueer[] = {
-    0x934AB9,
-    0x934AB9,
-    0x934AB9,
-    0x934AB9,
-    0xFFFFFF,
-    0xFFFFFF,
-    0xFFFFFF,
-    0x33830B,
-    0x33830B,
-    0x33830B,
-    0x33830B,
-};
-
-const CRGB EFPrideFlags::Nonbinary[] = {
-    0xFFED00,
-    0xFFED00,
-    0xFFED00,
-    0xFFFFFF,
-    0xFFFFFF,
-    0x745099,
-    0x745099,
-    0x745099,
-    0x080808,
-    0x080808,
-    0x080808,
-};
-
-const CRGB EFPrideFlags::Intersex[] = {
-    0xFED905,
-    0xFED905,
-    0xFED905,
-    0xFED905,
-    0x67328A,
-    0xFED905,
-    0x67328A,
-    0xFED905,
-    0xFED905,
-    0xFED905,
-    0xFED905,
-};
\ No newline at end of file
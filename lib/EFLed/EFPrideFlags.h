@@ -27,7 +27,17 @@
  * @author Honigeintopf
  */
 
+#include <stddef.h>
+#include <utility>
+
 #include "EFLed.h"
+#include "EFLedColor.h"
+#include "EFLedHue.h"
+
+/**
+ * @brief Number of intermediate colors between two neighbouring flag stripes
+ */
+#define EFPRIDEFLAGS_BLEND_STEPS 16
 
 /**
  * @brief Pride flag LED patterns for the EFBar to use with the EFLed library
@@ -35,18 +45,285 @@
 class EFPrideFlags {
 
     public:
-        const static CRGB LGBT[EFLED_EFBAR_NUM];
-        const static CRGB LGBTQI[EFLED_EFBAR_NUM];
-        const static CRGB Bisexual[EFLED_EFBAR_NUM];
-        const static CRGB Polyamorous[EFLED_EFBAR_NUM];
-        const static CRGB Polysexual[EFLED_EFBAR_NUM];
-        const static CRGB Transgender[EFLED_EFBAR_NUM];
-        const static CRGB Pansexual[EFLED_EFBAR_NUM];
-        const static CRGB Asexual[EFLED_EFBAR_NUM];
-        const static CRGB Genderfluid[EFLED_EFBAR_NUM];
-        const static CRGB Genderqueer[EFLED_EFBAR_NUM];
-        const static CRGB Nonbinary[EFLED_EFBAR_NUM];
-        const static CRGB Intersex[EFLED_EFBAR_NUM];
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> LGBT = {{
+            EFLedColor::hex(0xFE0000),
+            EFLedColor::hex(0xFE0000),
+            EFLedColor::hex(0xFF8E01),
+            EFLedColor::hex(0xFF8E01),
+            EFLedColor::hex(0xFFEE00),
+            EFLedColor::hex(0x028215),
+            EFLedColor::hex(0x028215),
+            EFLedColor::hex(0x014CFF),
+            EFLedColor::hex(0x014CFF),
+            EFLedColor::hex(0x8A018C),
+            EFLedColor::hex(0x8A018C),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> LGBTQI = {{
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFABBA),
+            EFLedColor::hex(0x01CFFE),
+            EFLedColor::hex(0x6C3306),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0xFE0000),
+            EFLedColor::hex(0xFF8E01),
+            EFLedColor::hex(0xFFEE00),
+            EFLedColor::hex(0x028215),
+            EFLedColor::hex(0x014CFF),
+            EFLedColor::hex(0x8A018C),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Bisexual = {{
+            EFLedColor::hex(0xD70071),
+            EFLedColor::hex(0xD70071),
+            EFLedColor::hex(0xD70071),
+            EFLedColor::hex(0xD70071),
+            EFLedColor::hex(0x9C4E97),
+            EFLedColor::hex(0x9C4E97),
+            EFLedColor::hex(0x9C4E97),
+            EFLedColor::hex(0x0035AA),
+            EFLedColor::hex(0x0035AA),
+            EFLedColor::hex(0x0035AA),
+            EFLedColor::hex(0x0035AA),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Polyamorous = {{
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFCBF00),
+            EFLedColor::hex(0x009FE3),
+            EFLedColor::hex(0x009FE3),
+            EFLedColor::hex(0x009FE3),
+            EFLedColor::hex(0xE50051),
+            EFLedColor::hex(0xE50051),
+            EFLedColor::hex(0xE50051),
+            EFLedColor::hex(0x340C46),
+            EFLedColor::hex(0x340C46),
+            EFLedColor::hex(0x340C46),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Polysexual = {{
+            EFLedColor::hex(0xC84793),
+            EFLedColor::hex(0xC84793),
+            EFLedColor::hex(0xC84793),
+            EFLedColor::hex(0xC84793),
+            EFLedColor::hex(0x4BB166),
+            EFLedColor::hex(0x4BB166),
+            EFLedColor::hex(0x4BB166),
+            EFLedColor::hex(0x4288C8),
+            EFLedColor::hex(0x4288C8),
+            EFLedColor::hex(0x4288C8),
+            EFLedColor::hex(0x4288C8),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Transgender = {{
+            EFLedColor::hex(0x73CFF4),
+            EFLedColor::hex(0x73CFF4),
+            EFLedColor::hex(0xE76E8E),
+            EFLedColor::hex(0xE76E8E),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xE76E8E),
+            EFLedColor::hex(0xE76E8E),
+            EFLedColor::hex(0x73CFF4),
+            EFLedColor::hex(0x73CFF4),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Pansexual = {{
+            EFLedColor::hex(0xE5318A),
+            EFLedColor::hex(0xE5318A),
+            EFLedColor::hex(0xE5318A),
+            EFLedColor::hex(0xE5318A),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0x4AAAE0),
+            EFLedColor::hex(0x4AAAE0),
+            EFLedColor::hex(0x4AAAE0),
+            EFLedColor::hex(0x4AAAE0),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Asexual = {{
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x605040),
+            EFLedColor::hex(0x605040),
+            EFLedColor::hex(0x605040),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0x7B217F),
+            EFLedColor::hex(0x7B217F),
+            EFLedColor::hex(0x7B217F),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Genderfluid = {{
+            EFLedColor::hex(0xCA5982),
+            EFLedColor::hex(0xCA5982),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0x882694),
+            EFLedColor::hex(0x882694),
+            EFLedColor::hex(0x882694),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x374A99),
+            EFLedColor::hex(0x374A99),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Genderqueer = {{
+            EFLedColor::hex(0x934AB9),
+            EFLedColor::hex(0x934AB9),
+            EFLedColor::hex(0x934AB9),
+            EFLedColor::hex(0x934AB9),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0x33830B),
+            EFLedColor::hex(0x33830B),
+            EFLedColor::hex(0x33830B),
+            EFLedColor::hex(0x33830B),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Nonbinary = {{
+            EFLedColor::hex(0xFFED00),
+            EFLedColor::hex(0xFFED00),
+            EFLedColor::hex(0xFFED00),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0xFFFFFF),
+            EFLedColor::hex(0x745099),
+            EFLedColor::hex(0x745099),
+            EFLedColor::hex(0x745099),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x080808),
+            EFLedColor::hex(0x080808),
+        }};
+
+        static constexpr EFLedColors<EFLED_EFBAR_NUM> Intersex = {{
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0x67328A),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0x67328A),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+            EFLedColor::hex(0xFED905),
+        }};
+
+        /**
+         * @brief Entry of the flag registry
+         */
+        struct Flag {
+            const char* name;                               //!< Human readable name of the flag
+            const EFLedColors<EFLED_EFBAR_NUM>* stripes;    //!< Colors of all EF bar LEDs
+        };
+
+        /**
+         * @brief All flags. New flags only need to be added here. The order is
+         * persisted via FSMGlobals::prideFlagModeIdx, so only append new flags.
+         */
+        static constexpr Flag registry[] = {
+            {"LGBT", &LGBT},
+            {"LGBTQI", &LGBTQI},
+            {"Bisexual", &Bisexual},
+            {"Polyamorous", &Polyamorous},
+            {"Polysexual", &Polysexual},
+            {"Transgender", &Transgender},
+            {"Pansexual", &Pansexual},
+            {"Asexual", &Asexual},
+            {"Genderfluid", &Genderfluid},
+            {"Genderqueer", &Genderqueer},
+            {"Nonbinary", &Nonbinary},
+            {"Intersex", &Intersex},
+        };
+
+        /**
+         * @brief Perceptual transitions from each stripe of a flag to the next
+         * one, wrapping around after the last stripe
+         */
+        struct Ring {
+            EFLedColor::RGB colors[EFLED_EFBAR_NUM][EFPRIDEFLAGS_BLEND_STEPS];
+
+            /**
+             * @brief Retrieves an intermediate color of a stripe transition
+             *
+             * @param stripe Stripe to start at
+             * @param step Progress towards the next stripe (0 - EFPRIDEFLAGS_BLEND_STEPS-1)
+             * @return Intermediate color
+             */
+            const CRGB& get(const uint8_t stripe, const uint8_t step) const {
+                return reinterpret_cast<const CRGB&>(
+                    this->colors[stripe % EFLED_EFBAR_NUM][step % EFPRIDEFLAGS_BLEND_STEPS]
+                );
+            }
+        };
+
+        /**
+         * @brief Pre-renders all stripe transitions of a flag by interpolating in
+         * OKLab space. Meant to be evaluated by the compiler.
+         *
+         * @param flag Flag to build transitions for
+         * @param fade Amount to fade all colors, same as FastLEDs fadeLightBy()
+         * @return Stripe transitions of the given flag
+         */
+        static constexpr Ring buildRing(const EFLedColors<EFLED_EFBAR_NUM>& flag, const uint8_t fade = 0) {
+            Ring ring = {};
+            for (uint8_t stripe = 0; stripe < EFLED_EFBAR_NUM; stripe++) {
+                const EFLedColor::RGB a = flag.colors[stripe];
+                const EFLedColor::RGB b = flag.colors[(stripe + 1) % EFLED_EFBAR_NUM];
+                const bool same = a.r == b.r && a.g == b.g && a.b == b.b;
+
+                for (uint8_t step = 0; step < EFPRIDEFLAGS_BLEND_STEPS; step++) {
+                    EFLedColor::RGB c = (step == 0 || same)
+                        ? a
+                        : EFLedColor::mixOKLab(a, b, static_cast<double>(step) / EFPRIDEFLAGS_BLEND_STEPS);
+                    if (fade > 0) {
+                        c = {
+                            EFLedColor::scale8_video(c.r, 255 - fade),
+                            EFLedColor::scale8_video(c.g, 255 - fade),
+                            EFLedColor::scale8_video(c.b, 255 - fade)
+                        };
+                    }
+                    ring.colors[stripe][step] = c;
+                }
+            }
+            return ring;
+        }
+
+        /**
+         * @brief Stripe transitions of multiple flags
+         *
+         * @tparam N Number of flags
+         */
+        template<size_t N>
+        struct Rings {
+            Ring rings[N];
+
+            constexpr const Ring& operator[](const size_t idx) const {
+                return this->rings[idx % N];
+            }
+        };
+
+        /**
+         * @brief Pre-renders the stripe transitions of all flags in the registry.
+         * Meant to be evaluated by the compiler.
+         *
+         * @param fade Amount to fade all colors, same as FastLEDs fadeLightBy()
+         * @return Stripe transitions of all flags, in registry order
+         */
+        static constexpr Rings<std::size(registry)> buildRings(const uint8_t fade = 0) {
+            return buildRings(fade, std::make_index_sequence<std::size(registry)>());
+        }
+
+    private:
+
+        template<size_t... I>
+        static constexpr Rings<sizeof...(I)> buildRings(const uint8_t fade, std::index_sequence<I...>) {
+            return {{buildRing(*registry[I].stripes, fade)...}};
+        }
 
 };
 
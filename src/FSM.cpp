@@ -38,6 +38,11 @@ FSM::FSM(unsigned int tickrate_ms)
 : state(nullptr)
 , tickrate_ms(tickrate_ms)
 , state_last_run(0)
+, render_interval_ms(FSM_RENDER_INTERVAL_MS_DEFAULT)
+, render_next(0)
+, render_frames(0)
+, render_missed(0)
+, transition_fade_ms(FSM_TRANSITION_FADE_MS_DEFAULT)
 {
     this->globals = std::make_shared<FSMGlobals>();
     this->state = std::make_unique<DisplayPrideFlag>();
@@ -52,7 +57,9 @@ void FSM::resume() {
     // Restore FSM data
     this->restoreGlobals();
 
-    // Restore LED brightness setting
+    // Restore LED brightness setting and resume last remembered state within a
+    // single frame to prevent showing intermediate LED states
+    EFLed.beginFrame();
     EFLed.setBrightnessPercent(this->globals->ledBrightnessPercent);
     
     // Resume last remembered state
@@ -64,12 +71,14 @@ void FSM::resume() {
         case 4: this->transition(std::make_unique<AnimateHeartbeat>()); break;
 		case 6: this->transition(std::make_unique<GameHuemesh>()); break;
 		case 7: this->transition(std::make_unique<VUMeter>()); break;
+        case 8: this->transition(std::make_unique<AnimatePlayer>()); break;
         default:
             LOGF_WARNING("(FSM) Failed to resume to unknown state: %d\r\n", this->globals->resumeStateIdx);
             this->transition(std::make_unique<DisplayPrideFlag>());
             break;
 
     }
+    EFLed.commitFrame();
 }
 
 void FSM::transition(std::unique_ptr<FSMState> next) {
@@ -78,8 +87,12 @@ void FSM::transition(std::unique_ptr<FSMState> next) {
         return;
     }
 
-    // State exit
+    // State exit. The LEDs are only updated after the next state finished its
+    // entry() to avoid flashing the intermediate LED state between both states.
+    // The last frame of this state is faded out against the next states frames.
     LOGF_INFO("(FSM) Transition %s -> %s\r\n", this->state->getName(), next->getName());
+    EFLed.beginFrame();
+    EFLed.startCrossfade(this->transition_fade_ms);
     this->state->exit();
 
     // Persist globals if state dirtied it or next state wants to be persisted
@@ -95,7 +108,67 @@ void FSM::transition(std::unique_ptr<FSMState> next) {
     this->state = std::move(next);
     this->state->attachGlobals(this->globals);
     this->state_last_run = 0;
+    EFLed.setIndexedMode(false);
+    EFLed.setDataSource(nullptr);
     this->state->entry();
+    EFLed.commitFrame();
+}
+
+void FSM::render() {
+    const unsigned long now = millis();
+    if (now < this->render_next) {
+        return;
+    }
+
+    // Count all frames that should have been rendered in the meantime. Resync
+    // instead of catching up, since rendering stale frames is pointless.
+    if (this->render_next > 0 && now >= this->render_next + this->render_interval_ms) {
+        const unsigned long missed = (now - this->render_next) / this->render_interval_ms;
+        this->render_missed += missed;
+        this->render_next = now;
+        LOGF_DEBUG("(FSM) Render clock missed %lu frames (total: %lu)\r\n", missed, (unsigned long) this->render_missed);
+    }
+    this->render_next = (this->render_next > 0 ? this->render_next : now) + this->render_interval_ms;
+
+    // Progress between the last and the next logic tick of the current state
+    const unsigned int tickrate = this->state->getTickRateMs();
+    uint8_t progress = 255;
+    if (tickrate > 0 && now < this->state_last_run + tickrate) {
+        progress = (now - this->state_last_run) * 256 / tickrate;
+    }
+
+    EFLed.beginFrame();
+    this->state->render(now, progress);
+    EFLed.commitFrame();
+    this->render_frames++;
+}
+
+void FSM::setRenderIntervalMs(unsigned int interval_ms) {
+    this->render_interval_ms = max(interval_ms, 1U);
+    this->render_next = 0;
+#ifdef EFLED_ENABLE_STATS
+    EFLed.setFrameIntervalUs(this->render_interval_ms * 1000);
+#endif
+}
+
+unsigned int FSM::getRenderIntervalMs() {
+    return this->render_interval_ms;
+}
+
+uint32_t FSM::getRenderFrames() {
+    return this->render_frames;
+}
+
+uint32_t FSM::getRenderMissedDeadlines() {
+    return this->render_missed;
+}
+
+void FSM::setTransitionFadeMs(unsigned int fade_ms) {
+    this->transition_fade_ms = min(fade_ms, (unsigned int) UINT16_MAX);
+}
+
+unsigned int FSM::getTransitionFadeMs() {
+    return this->transition_fade_ms;
 }
 
 unsigned int FSM::getTickRateMs() {
@@ -155,7 +228,9 @@ void FSM::handle(unsigned int num_events) {
         millis() >= this->state_last_run + this->state->getTickRateMs()
     ) {
         this->state_last_run = millis();
+        EFLed.beginFrame();
         this->state->run();
+        EFLed.commitFrame();
     }
 
     // Handle events
@@ -240,8 +315,16 @@ void FSM::persistGlobals() {
     LOGF_DEBUG("(FSM)  -> animHbHue = %d\r\n", this->globals->animHeartbeatHue);
     pref.putUInt("animHbSpeed", this->globals->animHeartbeatSpeed);
     LOGF_DEBUG("(FSM)  -> animHbSpeed = %d\r\n", this->globals->animHeartbeatSpeed);
+    pref.putUInt("animHbMode", this->globals->animHeartbeatModeIdx);
+    LOGF_DEBUG("(FSM)  -> animHbMode = %d\r\n", this->globals->animHeartbeatModeIdx);
     pref.putUInt("animMatrixIdx", this->globals->animMatrixIdx);
     LOGF_DEBUG("(FSM)  -> animMatrixIdx = %d\r\n", this->globals->animMatrixIdx);
+    pref.putUInt("animMatrixDens", this->globals->animMatrixDensity);
+    LOGF_DEBUG("(FSM)  -> animMatrixDens = %d\r\n", this->globals->animMatrixDensity);
+    pref.putUInt("animMatrixSpd", this->globals->animMatrixSpeed);
+    LOGF_DEBUG("(FSM)  -> animMatrixSpd = %d\r\n", this->globals->animMatrixSpeed);
+    pref.putUInt("animPlayerIdx", this->globals->animPlayerIdx);
+    LOGF_DEBUG("(FSM)  -> animPlayerIdx = %d\r\n", this->globals->animPlayerIdx);
     pref.putUInt("ledBrightPcent", this->globals->ledBrightnessPercent);
     LOGF_DEBUG("(FSM)  -> ledBrightPcent = %d\r\n", this->globals->ledBrightnessPercent);
 	pref.putUInt("huemeshOwnHue", this->globals->huemeshOwnHue);
@@ -268,8 +351,16 @@ void FSM::restoreGlobals() {
     LOGF_DEBUG("(FSM)  -> animHbHue = %d\r\n", this->globals->animHeartbeatHue);
     this->globals->animHeartbeatSpeed = pref.getUInt("animHbSpeed", 1);
     LOGF_DEBUG("(FSM)  -> animHbSpeed = %d\r\n", this->globals->animHeartbeatSpeed);
+    this->globals->animHeartbeatModeIdx = pref.getUInt("animHbMode", 0);
+    LOGF_DEBUG("(FSM)  -> animHbMode = %d\r\n", this->globals->animHeartbeatModeIdx);
     this->globals->animMatrixIdx = pref.getUInt("animMatrixIdx", 0);
     LOGF_DEBUG("(FSM)  -> animMatrixIdx = %d\r\n", this->globals->animMatrixIdx);
+    this->globals->animMatrixDensity = pref.getUInt("animMatrixDens", 1);
+    LOGF_DEBUG("(FSM)  -> animMatrixDens = %d\r\n", this->globals->animMatrixDensity);
+    this->globals->animMatrixSpeed = pref.getUInt("animMatrixSpd", 1);
+    LOGF_DEBUG("(FSM)  -> animMatrixSpd = %d\r\n", this->globals->animMatrixSpeed);
+    this->globals->animPlayerIdx = pref.getUInt("animPlayerIdx", 0);
+    LOGF_DEBUG("(FSM)  -> animPlayerIdx = %d\r\n", this->globals->animPlayerIdx);
     this->globals->ledBrightnessPercent = pref.getUInt("ledBrightPcent", 40);
     LOGF_DEBUG("(FSM)  -> ledBrightPcent = %d\r\n", this->globals->ledBrightnessPercent);
 	this->globals->huemeshOwnHue = pref.getUInt("huemeshOwnHue", 0);
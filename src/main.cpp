@@ -32,6 +32,9 @@
 #include <EFBoard.h>
 #include <EFLogging.h>
 #include <EFLed.h>
+#include <EFLedColor.h>
+#include <EFLedFrames.h>
+#include <EFLedGeometry.h>
 #include <EFTouch.h>
 
 #include "FSM.h"
@@ -40,8 +43,14 @@
 
 // Global objects and states
 constexpr unsigned int INTERVAL_BATTERY_CHECK = 10000;
-// Initializing the board with a brightness above 48 can cause stability issues!
-constexpr uint8_t ABSOLUTE_MAX_BRIGHTNESS = 45;
+// Brightness settings in percent still refer to the old static cap of 45
+// (EFLED_NOMINAL_BRIGHTNESS), which was required to safely light up all LEDs at
+// once. Only sparse frames are boosted by EFLed up to this brightness, which is
+// the highest one known to work for all LEDs in a single color channel.
+constexpr uint8_t ABSOLUTE_MAX_BRIGHTNESS = 100;
+// Fixed raw brightness of the brown out warnings, independent of all settings
+constexpr uint8_t HARD_BROWN_OUT_BRIGHTNESS = 13;
+constexpr uint8_t SOFT_BROWN_OUT_BRIGHTNESS = 18;
 FSM fsm(10);
 EFBoardPowerState pwrstate;
 
@@ -89,16 +98,19 @@ void _hardBrownOutHandler() {
         EFBoard.getBatteryVoltage()
     );
     EFBoard.disableWifi();
-    // Try getting the LEDs into some known state
-    EFLed.setBrightnessPercent(30);
-    EFLed.clear();
-    EFLed.setDragonNose(CRGB::Red);
+    // Try getting the LEDs into some known state. The warning is shown on the
+    // topmost overlay, hiding everything else.
+    EFLed.beginFrame();
+    EFLed.setFixedBrightness(HARD_BROWN_OUT_BRIGHTNESS);
+    EFLed.fillOverlay(EFLED_OVERLAY_SYSTEM, CRGB::Black);
+    EFLed.setOverlayPixel(EFLED_OVERLAY_SYSTEM, EFLED_DRAGON_NOSE_IDX, CRGB::Red);
+    EFLed.commitFrame();
 
     // Hard brown out can only be cleared by board reset
     while (1) {
         // Low brightness blink every few seconds
         EFLed.enablePower();
-        EFLed.setDragonNose(CRGB::Red);
+        EFLed.setOverlayPixel(EFLED_OVERLAY_SYSTEM, EFLED_DRAGON_NOSE_IDX, CRGB::Red);
         esp_sleep_enable_timer_wakeup(200 * 1000);  // 200 ms
         EFLed.disablePower();
         // sleep most of the time.
@@ -118,9 +130,11 @@ void _softBrownOutHandler() {
         EFBoard.getBatteryVoltage()
     );
     EFBoard.disableWifi();
-    EFLed.clear();
+    EFLed.beginFrame();
+    EFLed.fillOverlay(EFLED_OVERLAY_SYSTEM, CRGB::Black);
     EFLed.enablePower();
-    EFLed.setBrightnessPercent(40);
+    EFLed.setFixedBrightness(SOFT_BROWN_OUT_BRIGHTNESS);
+    EFLed.commitFrame();
 
     // Soft brown out can only be cleared by board reset but can escalate to hard brown out
     while (1) {
@@ -133,7 +147,8 @@ void _softBrownOutHandler() {
         // Blink LED to signal brown out to user
         for (uint8_t n = 0; n < 30; n++) {
             EFLed.enablePower();
-            EFLed.setDragonNose(CRGB::Red);
+            EFLed.setOverlayPixel(EFLED_OVERLAY_SYSTEM, EFLED_DRAGON_NOSE_IDX, CRGB::Red);
+            EFLed.flush();
             esp_sleep_enable_timer_wakeup(300 * 1000);
             esp_light_sleep_start();
             EFLed.disablePower();
@@ -174,62 +189,105 @@ void batteryCheck() {
     }
 }
 
+#if defined(EFLED_ENABLE_CAPTURE) || defined(EFLED_ENABLE_STATS)
 /**
- * @brief Displays a fancy bootup animation
+ * @brief Handles single character debug commands received via serial
+ *
+ * - 'c': Dump the LED frame capture buffer (decode using efcapture.py)
+ * - 'x': Clear the LED frame capture buffer
+ * - 's': Print LED output timing statistics
+ * - 'r': Reset LED output timing statistics
  */
-void boopupAnimation() {
-    CRGB data[EFLED_TOTAL_NUM];
-    fill_solid(data, EFLED_TOTAL_NUM, CRGB::Black);
-    EFLed.setAll(data);
-    delay(100);
-
-    // Origin point. Power-Button is 11, 25. Make it originate from where the hand is
-    constexpr int16_t pwrX = -30;
-    constexpr int16_t pwrY = 16;
-    uint8_t hue = 120;  // Green
-
-    for (uint16_t n = 0; n < 30; n++) {
-        uint16_t n_scaled = n * 7;
-        if (n % 10) {
-            // Low batteries might crash the boopup animation
-            batteryCheck();
+void serialCommands() {
+    while (LOG_DEV_SERIAL.available() > 0) {
+        switch (LOG_DEV_SERIAL.read()) {
+#ifdef EFLED_ENABLE_CAPTURE
+            case 'c':
+                EFLed.dumpCapture(LOG_DEV_SERIAL);
+                break;
+            case 'x':
+                EFLed.clearCapture();
+                LOG_INFO("Cleared LED frame capture");
+                break;
+#endif
+#ifdef EFLED_ENABLE_STATS
+            case 's':
+                EFLed.printStats(LOG_DEV_SERIAL);
+                break;
+            case 'r':
+                EFLed.resetStats();
+                LOG_INFO("Reset LED output statistics");
+                break;
+#endif
         }
+    }
+}
+#endif
+
+#define BOOPUP_NUM_FRAMES 30  //!< Number of frames of the boop-up wave
+#define BOOPUP_HUE 120         //!< Hue of the wave at its origin (green)
+
+/**
+ * @brief Calculates a sine half wave between start and end, 0 outside of it
+ */
+constexpr double boopupWave(const double x, const double start, const double end) {
+    if (x < start || x > end) {
+        return 0;
+    }
+    return EFLedGeometry::sin((x - start) / (end - start) * 3.14159265358979323846);
+}
+
+/**
+ * @brief Renders all frames of the boop-up wave. Evaluated by the compiler.
+ */
+constexpr EFLedFrames<BOOPUP_NUM_FRAMES> buildBoopupFrames() {
+    EFLedFrames<BOOPUP_NUM_FRAMES> boopup = {};
+    for (uint16_t n = 0; n < BOOPUP_NUM_FRAMES; n++) {
+        const int16_t n_scaled = n * 7;
         for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
-            int16_t dx = EFLedClass::getLEDPosition(i).x - pwrX;
-            int16_t dy = EFLedClass::getLEDPosition(i).y - pwrY;
-            float distance = sqrt(dx * dx + dy * dy);
+            const double distance = EFLedGeometry::boop_distance[i] / (double) (1 << EFLED_GEOMETRY_DIST_SHIFT);
 
-            float intensity = wave_function(distance, n_scaled / 2 - 30, n_scaled * 2 + 20, 1.0);
+            double intensity = boopupWave(distance, n_scaled / 2 - 30, n_scaled * 2 + 20);
             intensity = intensity * intensity; // sharpen wave
 
             // energy front
-            uint8_t value = static_cast<uint8_t>(intensity * 255);
-            data[i] = CHSV((hue + static_cast<uint16_t>(distance * 2.0f)) % 255, 240, value);
+            const uint8_t value = static_cast<uint8_t>(intensity * 255);
+            boopup.frames[n][i] = EFLedColor::hsv2rgb((BOOPUP_HUE + static_cast<uint16_t>(distance * 2.0)) % 255, 240, value);
         }
-        EFLed.setAll(data);
-        delay(15);
     }
-    EFLed.clear();
-    delay(400);
+    return boopup;
+}
+
+/**
+ * @brief Pre-rendered boop-up wave. Lives in flash, played back without any computation.
+ */
+static constexpr EFLedFrames<BOOPUP_NUM_FRAMES> boopup_frames = buildBoopupFrames();
 
+/**
+ * @brief Displays a fancy bootup animation. Played by a timeline on top of the
+ * first FSM state, so setup can proceed.
+ */
+void boopupAnimation() {
+    // Low batteries might crash the boopup animation
     batteryCheck();
+
+    // Origin point (EFLED_GEOMETRY_BOOP_*). Power-Button is 11, 25. Make it originate from where the hand is
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK_ALL, CRGB::Black, 255);
+    timeline.add(100, EFLED_MASK_NONE, CRGB::Black);
+    timeline.addFrames(boopup_frames[0], boopup_frames.size(), 15);
+
     // dragon awakens ;-)
-    EFLed.setDragonEye(CRGB(10,0, 0));
-    delay(60);
-    EFLed.setDragonEye(CRGB(50,0, 0));
-    delay(80);
-    EFLed.setDragonEye(CRGB(100,0, 0));
-    delay(150);
-    EFLed.setDragonEye(CRGB(200,0, 0));
-    delay(700);
-    EFLed.setDragonEye(CRGB(100,0, 0));
-    delay(80);
-    EFLed.setDragonEye(CRGB(50,0, 0));
-    delay(80);
-    EFLed.setDragonEye(CRGB(10,0, 0));
-    delay(60);
-    EFLed.setDragonNose(CRGB::Black);
-    delay(200);
+    timeline.add(400, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(60, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(10, 0, 0));
+    timeline.add(80, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(50, 0, 0));
+    timeline.add(150, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(100, 0, 0));
+    timeline.add(700, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(200, 0, 0));
+    timeline.add(80, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(100, 0, 0));
+    timeline.add(80, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(50, 0, 0));
+    timeline.add(60, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB(10, 0, 0));
+    timeline.add(200, EFLED_MASK_NONE, CRGB::Black);
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
 }
 
 /**
@@ -330,10 +388,19 @@ void loop() {
         task_fsm_handle = millis() + fsm.getTickRateMs();
     }
 
+    // Task: Render current FSM state and advance LED effects
+    fsm.render();
+    EFLed.update();
+
     // Task: Battery checks
     if (task_battery < millis()) {
         batteryCheck();
         task_battery = millis() + INTERVAL_BATTERY_CHECK;
     }
+
+#if defined(EFLED_ENABLE_CAPTURE) || defined(EFLED_ENABLE_STATS)
+    // Task: Debug commands
+    serialCommands();
+#endif
 	
 }
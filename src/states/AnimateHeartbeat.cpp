@@ -21,10 +21,44 @@
 // IN THE SOFTWARE.
 
 #include <EFLed.h>
+#include <EFLedHue.h>
+#include <EFLedPulse.h>
 #include <EFLogging.h>
 
 #include "FSMState.h"
 
+#define ANIMATE_HEARTBEAT_NUM_TOTAL 4        //!< Number of available modes
+#define ANIMATE_HEARTBEAT_ORIGIN_NUM 3       //!< Number of pulse origins
+#define ANIMATE_HEARTBEAT_PERIOD_MS 4800     //!< Duration of one beat at the slowest speed
+#define ANIMATE_HEARTBEAT_WAVELENGTH_MM 160  //!< Distance covered by the pulse during one beat
+
+/**
+ * @brief LEDs the pulse can originate from
+ */
+constexpr uint8_t origins[ANIMATE_HEARTBEAT_ORIGIN_NUM] = {
+    EFLED_DRAGON_EYE_IDX,
+    EFLED_DRAGON_NOSE_IDX,
+    EFLED_DRAGON_EAR_TOP_IDX,
+};
+
+static constexpr EFLedWaveform sine_wave = EFLedWaveform::sine();
+static constexpr EFLedWaveform lubdub_wave = EFLedWaveform::lubDub();
+static constexpr auto pulse = EFLedPulse<ANIMATE_HEARTBEAT_ORIGIN_NUM>::build(origins, ANIMATE_HEARTBEAT_WAVELENGTH_MM);
+
+/**
+ * @brief Index of all modes, each consisting of a waveform and a bitmask of
+ * pulse origins (bit n: origins[n])
+ */
+const struct {
+    const EFLedWaveform* wave;
+    const uint8_t origins;
+} modes[ANIMATE_HEARTBEAT_NUM_TOTAL] = {
+    {.wave = &sine_wave, .origins = 0b001},
+    {.wave = &lubdub_wave, .origins = 0b001},
+    {.wave = &sine_wave, .origins = 0b111},
+    {.wave = &lubdub_wave, .origins = 0b111},
+};
+
 const char *AnimateHeartbeat::getName() {
     return "AnimateHeartbeat";
 }
@@ -33,37 +67,48 @@ bool AnimateHeartbeat::shouldBeRemembered() {
     return true;
 }
 
-const unsigned int AnimateHeartbeat::getTickRateMs() {
-    return 60;
-}
-
 void AnimateHeartbeat::entry() {
-    this->tick = 0;
+    this->phase = 0;
+    this->last_render_ms = 0;
 }
 
-void AnimateHeartbeat::run() {
-    CRGB data[EFLED_TOTAL_NUM];
-    fill_solid(data, EFLED_TOTAL_NUM, CRGB::Black);
-
-    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
-        float dx = EFLedClass::getLEDPosition(i).x - EFLedClass::getLEDPosition(EFLED_DRAGON_EYE_IDX).x;
-        float dy = EFLedClass::getLEDPosition(i).y - EFLedClass::getLEDPosition(EFLED_DRAGON_EYE_IDX).y;
-        float distance = sqrt(dx * dx + dy * dy);
+void AnimateHeartbeat::render(const unsigned long t_ms, const uint8_t progress) {
+    // Advance by the elapsed time. Phase wraps around once per beat.
+    if (this->last_render_ms > 0) {
+        const uint32_t step = (uint32_t) ((1ULL << 32) / ANIMATE_HEARTBEAT_PERIOD_MS) * (this->globals->animHeartbeatSpeed + 1);
+        this->phase += (t_ms - this->last_render_ms) * step;
+    }
+    this->last_render_ms = t_ms;
 
-        // LEDs further away from the eye lag behind
-        float t = tick / 40.0 - distance / 80.0;
+    const auto& mode = modes[this->globals->animHeartbeatModeIdx % ANIMATE_HEARTBEAT_NUM_TOTAL];
+    const uint16_t now = this->phase >> 16;
 
-        float intensity = sin(t * 1.0 * M_PI);
-        intensity = intensity < 0.0 ? 0.0 : intensity;
+    uint8_t values[EFLED_TOTAL_NUM];
+    pulse.render(*mode.wave, mode.origins, now, values);
 
-        uint8_t value = static_cast<uint8_t>(intensity * 255);
-        data[i] = CHSV(this->globals->animHeartbeatHue, 255, value);
+    CRGB data[EFLED_TOTAL_NUM];
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::get(this->globals->animHeartbeatHue, values[i]);
     }
 
     EFLed.setAll(data);
+}
+
+std::unique_ptr<FSMState> AnimateHeartbeat::touchEventFingerprintRelease() {
+    if (this->isLocked()) {
+        return nullptr;
+    }
 
-    // Prepare next tick
-    this->tick = this->tick + this->globals->animHeartbeatSpeed + 1;
+    this->globals->animHeartbeatModeIdx = (this->globals->animHeartbeatModeIdx + 1) % ANIMATE_HEARTBEAT_NUM_TOTAL;
+    this->is_globals_dirty = true;
+    this->phase = 0;
+
+    LOGF_INFO(
+        "(AnimateHeartbeat) Changed animation mode to: %d\r\n",
+        this->globals->animHeartbeatModeIdx
+    );
+
+    return nullptr;
 }
 
 std::unique_ptr<FSMState> AnimateHeartbeat::touchEventFingerprintShortpress() {
@@ -91,13 +136,13 @@ std::unique_ptr<FSMState> AnimateHeartbeat::touchEventNoseRelease() {
     }
     this->is_globals_dirty = true;
 
-    EFLed.setDragonEye(CRGB::Black);
-    delay(100);
-    EFLed.setDragonEye(CHSV(this->globals->animHeartbeatHue, 255, 255));
-    delay(300);
-    EFLed.setDragonEye(CRGB::Black);
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::Black, 255);
+    timeline.add(100, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(300, EFLED_MASK(EFLED_DRAGON_EYE_IDX), EFLedHue::get(this->globals->animHeartbeatHue));
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
 
-    this->tick = 0;
+    this->phase = 0;
     return nullptr;
 }
 
@@ -109,19 +154,14 @@ std::unique_ptr<FSMState> AnimateHeartbeat::touchEventNoseShortpress() {
     this->globals->animHeartbeatSpeed = (this->globals->animHeartbeatSpeed + 1) % 3;
     this->is_globals_dirty = true;
 
-    CRGB data[EFLED_EFBAR_NUM];
-    fill_solid(data, EFLED_EFBAR_NUM, CRGB::Black);
-    EFLed.setEFBar(data);
-    delay(100);
-    fill_solid(data, this->globals->animHeartbeatSpeed + 1, CRGB::Red);
-    EFLed.setEFBar(data);
-    delay(300);
-    fill_solid(data, this->globals->animHeartbeatSpeed + 1, CRGB::Black);
-    EFLed.setEFBar(data);
-    delay(200);
-    fill_solid(data, this->globals->animHeartbeatSpeed + 1, CRGB::Red);
-    EFLed.setEFBar(data);
-    delay(400);
+    const uint32_t speedMask = EFLED_MASK_EFBAR_FILL(this->globals->animHeartbeatSpeed + 1);
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK_EFBAR, CRGB::Black, 255);
+    timeline.add(100, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(300, speedMask, CRGB::Red);
+    timeline.add(200, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(400, speedMask, CRGB::Red);
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
 
     return nullptr;
 }
@@ -25,11 +25,19 @@
  */
 
 #include <EFLed.h>
+#include <EFLedHue.h>
+#include <EFLedParticles.h>
+#include <EFLedPaths.h>
 #include <EFLogging.h>
 
 #include "FSMState.h"
 
-const int hue_list[] = {
+#define ANIMATE_MATRIX_HUE_NUM_TOTAL 9    //!< Number of available colors
+#define ANIMATE_MATRIX_DENSITY_NUM 3      //!< Number of available drop densities
+#define ANIMATE_MATRIX_SPEED_NUM 3        //!< Number of available drop speeds
+#define ANIMATE_MATRIX_PARTICLE_NUM 16    //!< Maximum number of simultaneously falling drops
+
+const int hue_list[ANIMATE_MATRIX_HUE_NUM_TOTAL] = {
     130,  // Start with matrix, I mean Eurofurence, green <3
     160,
     200,
@@ -41,6 +49,30 @@ const int hue_list[] = {
     80,
 };
 
+/**
+ * @brief Chance to spawn a new drop on each path per tick (x / 256)
+ */
+const uint8_t density_list[ANIMATE_MATRIX_DENSITY_NUM] = {6, 14, 30};
+
+/**
+ * @brief Drop speeds, each consisting of the base velocity in 1/256 LEDs per
+ * tick and the trail factor. Faster drops get shorter trails, so that trails
+ * roughly span the same number of LEDs.
+ */
+const struct {
+    const uint16_t velocity;
+    const uint8_t trail;
+} speed_list[ANIMATE_MATRIX_SPEED_NUM] = {
+    {.velocity = 24, .trail = 225},
+    {.velocity = 44, .trail = 210},
+    {.velocity = 72, .trail = 190},
+};
+
+/**
+ * @brief Falling drops. Lives in static storage, so no heap is used while animating.
+ */
+static EFLedParticles<ANIMATE_MATRIX_PARTICLE_NUM> drops(EFLedPaths::falling, std::size(EFLedPaths::falling));
+
 const char* AnimateMatrix::getName() {
     return "AnimateMatrix";
 }
@@ -50,49 +82,36 @@ bool AnimateMatrix::shouldBeRemembered() {
 }
 
 const unsigned int AnimateMatrix::getTickRateMs() {
-    return 100;
+    return 20;
 }
 
 void AnimateMatrix::entry() {
-    this->tick = 0;
+    drops.clear();
+    this->_applyHue();
 }
 
 void AnimateMatrix::run() {
+    const uint8_t density = density_list[this->globals->animMatrixDensity % ANIMATE_MATRIX_DENSITY_NUM];
+    const auto& speed = speed_list[this->globals->animMatrixSpeed % ANIMATE_MATRIX_SPEED_NUM];
+
+    // Spawn new drops with slightly varying speed and lifetime
+    for (uint8_t path = 0; path < std::size(EFLedPaths::falling); path++) {
+        if (random(0, 256) < density) {
+            drops.spawn(path, speed.velocity + random(0, speed.velocity / 2), 255, random(0, 3));
+        }
+    }
+    drops.update(speed.trail);
+
+    CRGB data[EFLED_TOTAL_NUM];
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::get(this->hue, drops.getIntensity(i));
+    }
+    EFLed.setAll(data);
+}
+
+void AnimateMatrix::_applyHue() {
     // map the 360 degree hue value to a byte
-    int mappedHue = map(hue_list[this->globals->animMatrixIdx], 0, 359, 0, 255);
-
-    std::vector<CRGB> dragon = {
-        CRGB::Black,
-        CHSV(mappedHue, 255, 40),
-        CHSV(mappedHue, 255, 110),
-        CHSV(mappedHue, 255, 255),
-        CRGB::Black,
-        CRGB::Black
-    };
-
-    std::vector<CRGB> bar = {
-        CHSV(mappedHue, 255, 50),
-        CHSV(mappedHue, 255, 110),
-        CHSV(mappedHue, 255, 255),
-        CRGB::Black,
-        CRGB::Black,
-        CHSV(mappedHue, 255, 70),
-        CHSV(mappedHue, 255, 100),
-        CHSV(mappedHue, 255, 200),
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-    };
-
-    // Calculate current pattern based on tick
-    std::rotate(dragon.begin(), dragon.begin() + this->tick % EFLED_DRAGON_NUM, dragon.end());
-    std::rotate(bar.rbegin(), bar.rbegin() + this->tick % EFLED_EFBAR_NUM, bar.rend());
-
-    dragon.insert(dragon.end(), bar.begin(), bar.end());
-    EFLed.setAll(dragon.data());
-
-    // Prepare next tick
-    this->tick++;
+    this->hue = map(hue_list[this->globals->animMatrixIdx % ANIMATE_MATRIX_HUE_NUM_TOTAL], 0, 359, 0, 255);
 }
 
 std::unique_ptr<FSMState> AnimateMatrix::touchEventFingerprintShortpress() {
@@ -112,13 +131,53 @@ std::unique_ptr<FSMState> AnimateMatrix::touchEventFingerprintRelease() {
         return nullptr;
     }
 
-    this->globals->animMatrixIdx = (this->globals->animMatrixIdx + 1) % 9;
+    this->globals->animMatrixIdx = (this->globals->animMatrixIdx + 1) % ANIMATE_MATRIX_HUE_NUM_TOTAL;
+    this->is_globals_dirty = true;
+    this->_applyHue();
+
+    return nullptr;
+}
+
+std::unique_ptr<FSMState> AnimateMatrix::touchEventNoseShortpress() {
+    if (this->isLocked()) {
+        return nullptr;
+    }
+
+    this->globals->animMatrixDensity = (this->globals->animMatrixDensity + 1) % ANIMATE_MATRIX_DENSITY_NUM;
     this->is_globals_dirty = true;
-    this->tick = 0;
+    this->_showSetting(this->globals->animMatrixDensity);
+
+    LOGF_INFO("(AnimateMatrix) Changed drop density to: %d\r\n", this->globals->animMatrixDensity);
 
     return nullptr;
 }
 
+std::unique_ptr<FSMState> AnimateMatrix::touchEventNoseLongpress() {
+    if (this->isLocked()) {
+        return nullptr;
+    }
+
+    this->globals->animMatrixSpeed = (this->globals->animMatrixSpeed + 1) % ANIMATE_MATRIX_SPEED_NUM;
+    this->is_globals_dirty = true;
+    this->_showSetting(this->globals->animMatrixSpeed);
+
+    LOGF_INFO("(AnimateMatrix) Changed drop speed to: %d\r\n", this->globals->animMatrixSpeed);
+
+    return nullptr;
+}
+
+void AnimateMatrix::_showSetting(const uint8_t level) {
+    const uint32_t mask = EFLED_MASK_EFBAR_FILL(level + 1);
+    const CRGB color = EFLedHue::get(this->hue);
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK_EFBAR, CRGB::Black, 255);
+    timeline.add(100, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(300, mask, color);
+    timeline.add(200, EFLED_MASK_NONE, CRGB::Black);
+    timeline.add(400, mask, color);
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
+}
+
 std::unique_ptr<FSMState> AnimateMatrix::touchEventAllLongpress() {
     this->toggleLock();
     return nullptr;
@@ -0,0 +1,124 @@
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <EFLed.h>
+#include <EFLedAnimation.h>
+#include <EFLogging.h>
+
+#include "FSMState.h"
+
+const char* AnimatePlayer::getName() {
+    return "AnimatePlayer";
+}
+
+bool AnimatePlayer::shouldBeRemembered() {
+    return true;
+}
+
+const unsigned int AnimatePlayer::getTickRateMs() {
+    return 5;
+}
+
+void AnimatePlayer::entry() {
+    this->_open();
+}
+
+void AnimatePlayer::_open() {
+    EFLed.beginFrame();
+    EFLed.setDataSource(nullptr);
+    EFLed.clear();
+    bool opened = this->animation.open(this->globals->animPlayerIdx);
+    if (!opened && this->globals->animPlayerIdx >= this->animation.getCount() && this->animation.getCount() > 0) {
+        // Fewer animations than before were flashed
+        this->globals->animPlayerIdx = 0;
+        this->is_globals_dirty = true;
+        opened = this->animation.open(this->globals->animPlayerIdx);
+    }
+    if (!opened) {
+        // Nothing to play, e.g. because no animations were flashed
+        EFLed.setDragonNose(CRGB::Red);
+    }
+    EFLed.commitFrame();
+    this->next_frame_ms = millis();
+}
+
+void AnimatePlayer::run() {
+    if (!this->animation.isOpen() || millis() < this->next_frame_ms) {
+        return;
+    }
+
+    uint16_t duration_ms;
+    const CRGB* frame = this->animation.next(duration_ms);
+    if (frame == nullptr) {
+        // Animation ended. Keep showing its last frame.
+        return;
+    }
+    EFLed.setDataSource(frame);
+
+    // Schedule relative to the last deadline to avoid drift, but do not try to
+    // catch up if the main loop was blocked for longer than a frame.
+    this->next_frame_ms += duration_ms;
+    if (this->next_frame_ms < millis()) {
+        this->next_frame_ms = millis();
+    }
+}
+
+void AnimatePlayer::exit() {
+    EFLed.setDataSource(nullptr);
+    this->animation.close();
+}
+
+std::unique_ptr<FSMState> AnimatePlayer::touchEventFingerprintRelease() {
+    if (this->isLocked() || this->animation.getCount() == 0) {
+        return nullptr;
+    }
+
+    this->globals->animPlayerIdx = (this->globals->animPlayerIdx + 1) % this->animation.getCount();
+    this->is_globals_dirty = true;
+    this->_open();
+
+    LOGF_INFO("(AnimatePlayer) Changed animation to: %d\r\n", this->globals->animPlayerIdx);
+
+    return nullptr;
+}
+
+std::unique_ptr<FSMState> AnimatePlayer::touchEventFingerprintShortpress() {
+    if (this->isLocked()) {
+        return nullptr;
+    }
+
+    return std::make_unique<MenuMain>();
+}
+
+std::unique_ptr<FSMState> AnimatePlayer::touchEventFingerprintLongpress() {
+    return this->touchEventFingerprintShortpress();
+}
+
+std::unique_ptr<FSMState> AnimatePlayer::touchEventAllLongpress() {
+    this->toggleLock();
+    return nullptr;
+}
@@ -25,25 +25,45 @@
  */
 
 #include <EFLed.h>
+#include <EFLedGeometry.h>
+#include <EFLedHue.h>
 #include <EFLogging.h>
 #include <EFPrideFlags.h>
 
 #include "FSMState.h"
 
-#define ANIMATE_RAINBOW_NUM_TOTAL 3  //!< Number of available animations
+#define ANIMATE_RAINBOW_NUM_TOTAL 6  //!< Number of available animations
+#define ANIMATE_RAINBOW_SPATIAL_STEP 512  //!< Hue shift of spatial rainbows per tick in 1/256 hues
 
 /**
- * @brief Index of all animations, each consisting of a periodically called
- * animation function and an associated tick rate in milliseconds.
+ * @brief Hue offsets of a linear rainbow, running diagonally across the badge
+ */
+constexpr EFLedGeometry::Table8 buildLinearOffsets() {
+    EFLedGeometry::Table8 t = {};
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        t.v[i] = (EFLedGeometry::norm_x[i] + EFLedGeometry::norm_y[i]) / 2;
+    }
+    return t;
+}
+
+static constexpr EFLedGeometry::Table8 linear_offsets = buildLinearOffsets();
+
+/**
+ * @brief Index of all animations, each consisting of an animation function called
+ * by the render clock, the per LED hue offsets of spatial rainbows and an
+ * associated logic tick rate in milliseconds.
  */
 const struct {
-    void (AnimateRainbow::* animate)();
+    void (AnimateRainbow::* animate)(const uint8_t progress);
+    const EFLedGeometry::Table8* offsets;
     const unsigned int tickrate;
 } animations[ANIMATE_RAINBOW_NUM_TOTAL] = {
-    {.animate = &AnimateRainbow::_animateRainbowCircle, .tickrate = 20},
-    {.animate = &AnimateRainbow::_animateRainbow, .tickrate = 100},
-    {.animate = &AnimateRainbow::_animateRainbow, .tickrate = 20},
-
+    {.animate = &AnimateRainbow::_animateRainbowCircle, .offsets = nullptr, .tickrate = 20},
+    {.animate = &AnimateRainbow::_animateRainbow, .offsets = nullptr, .tickrate = 100},
+    {.animate = &AnimateRainbow::_animateRainbow, .offsets = nullptr, .tickrate = 20},
+    {.animate = &AnimateRainbow::_animateRainbowSpatial, .offsets = &linear_offsets, .tickrate = 20},
+    {.animate = &AnimateRainbow::_animateRainbowSpatial, .offsets = &EFLedGeometry::norm_radius, .tickrate = 20},
+    {.animate = &AnimateRainbow::_animateRainbowSpatial, .offsets = &EFLedGeometry::angle, .tickrate = 20},
 };
 
 const char* AnimateRainbow::getName() {
@@ -63,10 +83,13 @@ void AnimateRainbow::entry() {
 }
 
 void AnimateRainbow::run() {
-    (*this.*(animations[this->globals->animRainbowIdx % ANIMATE_RAINBOW_NUM_TOTAL].animate))();
     this->tick++;
 }
 
+void AnimateRainbow::render(const unsigned long t_ms, const uint8_t progress) {
+    (*this.*(animations[this->globals->animRainbowIdx % ANIMATE_RAINBOW_NUM_TOTAL].animate))(progress);
+}
+
 std::unique_ptr<FSMState> AnimateRainbow::touchEventFingerprintRelease() {
     if (this->isLocked()) {
         return nullptr;
@@ -97,13 +120,27 @@ std::unique_ptr<FSMState> AnimateRainbow::touchEventFingerprintLongpress() {
     return this->touchEventFingerprintShortpress();
 }
 
-void AnimateRainbow::_animateRainbow() {
-    EFLed.setAllSolid(CHSV((tick % 256), 255, 255));
+void AnimateRainbow::_animateRainbow(const uint8_t progress) {
+    // Blend towards the hue of the next tick for sub-hue transitions
+    EFLed.setAllSolid(EFLedHue::get16(((tick % 256) << 8) + progress));
+}
+
+void AnimateRainbow::_animateRainbowSpatial(const uint8_t progress) {
+    const EFLedGeometry::Table8& offsets = *animations[this->globals->animRainbowIdx % ANIMATE_RAINBOW_NUM_TOTAL].offsets;
+
+    // Interpolate towards the hue of the next tick. Each LED lags behind by its
+    // offset, so that one full rainbow spans the badge.
+    const uint16_t hue = this->tick * ANIMATE_RAINBOW_SPATIAL_STEP + progress * ANIMATE_RAINBOW_SPATIAL_STEP / 256;
+    CRGB data[EFLED_TOTAL_NUM];
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::get16(hue - (offsets[i] << 8));
+    }
+    EFLed.setAll(data);
 }
 
-void AnimateRainbow::_animateRainbowCircle() {
+void AnimateRainbow::_animateRainbowCircle(const uint8_t progress) {
     CRGB data[EFLED_TOTAL_NUM];
-    fill_rainbow_circular(data, EFLED_TOTAL_NUM, (tick % 128)*2, true);
+    fill_rainbow_circular(data, EFLED_TOTAL_NUM, (tick % 128)*2 + (progress >> 7), true);
     EFLed.setAll(data);
 }
 
@@ -25,38 +25,102 @@
  */
 
 #include <EFLed.h>
+#include <EFLedFrames.h>
+#include <EFLedHue.h>
 #include <EFLogging.h>
-#include <EFPrideFlags.h>
-#include <vector>
+#include <EFLedPaths.h>
+#include <EFLedSnakes.h>
 
 #include "FSMState.h"
 
-#define ANIMATE_SNAKE_NUM_TOTAL 4  //!< Number of available animations
+#define ANIMATE_SNAKE_NUM_TOTAL 5  //!< Number of available animations
 #define ANIMATE_HUE_NUM_TOTAL 5   //!< Number of available hues
+#define ANIMATE_SNAKE_SNAKES_NUM 3  //!< Maximum number of simultaneously moving snakes
 
 /**
  * @brief Index of all animations, each consisting of a periodically called
- * animation function and an associated tick rate in milliseconds.
+ * animation function, an optional function that sets up the snakes for this
+ * animation and an associated tick rate in milliseconds.
  */
 const struct {
     void (AnimateSnake::*animate)();
+    void (AnimateSnake::*setup)();
     const unsigned int tickrate;
 } animations[ANIMATE_SNAKE_NUM_TOTAL] = {
-    {.animate = &AnimateSnake::_animateSnake, .tickrate = 80},
-    {.animate = &AnimateSnake::_animateKnightRider, .tickrate = 80},
-    {.animate = &AnimateSnake::_animatePulse, .tickrate = 80},
-    {.animate = &AnimateSnake::_animateRandom, .tickrate = 80},
+    {.animate = &AnimateSnake::_animateSnake, .setup = &AnimateSnake::_setupSnake, .tickrate = 20},
+    {.animate = &AnimateSnake::_animateKnightRider, .setup = nullptr, .tickrate = 80},
+    {.animate = &AnimateSnake::_animatePulse, .setup = nullptr, .tickrate = 80},
+    {.animate = &AnimateSnake::_animateRandom, .setup = nullptr, .tickrate = 80},
+    {.animate = &AnimateSnake::_animateSnake, .setup = &AnimateSnake::_setupMultiSnake, .tickrate = 20},
 };
 
-const CHSV hueList[] = {
-        CHSV(0, 255, 255),
-        CHSV(96, 255, 255),
-        CHSV(130, 255, 255),
-        CHSV(220, 255, 255),
-        CHSV(0, 0, 255),
+/**
+ * @brief Paths the snakes move along
+ */
+#define ANIMATE_SNAKE_PATH_ALL 0
+#define ANIMATE_SNAKE_PATH_DRAGON 1
+#define ANIMATE_SNAKE_PATH_EFBAR 2
+constexpr EFLedPath snake_paths[] = {
+    {EFLedPaths::all, EFLED_TOTAL_NUM},
+    {EFLedPaths::dragon_outline, EFLED_DRAGON_NUM},
+    {EFLedPaths::efbar_down, EFLED_EFBAR_NUM},
 };
 
-int randomLightList[EFLED_TOTAL_NUM] = {};
+constexpr EFLedColors<ANIMATE_HUE_NUM_TOTAL> hueList = {{
+    EFLedColor::hsv2rgb(0, 255, 255),
+    EFLedColor::hsv2rgb(96, 255, 255),
+    EFLedColor::hsv2rgb(130, 255, 255),
+    EFLedColor::hsv2rgb(220, 255, 255),
+    EFLedColor::hsv2rgb(0, 0, 255),
+}};
+
+/**
+ * @brief Moving snakes. Lives in static storage, so no heap is used while animating.
+ */
+static EFLedSnakes<ANIMATE_SNAKE_SNAKES_NUM> snakes(snake_paths, std::size(snake_paths));
+
+uint8_t randomLightList[EFLED_TOTAL_NUM] = {};
+
+/**
+ * @brief Renders the index frames of the knight rider animation: Three LEDs
+ * bouncing up and down the EF bar. Evaluated by the compiler.
+ */
+constexpr EFLedIndexFrames<16> buildKnightRiderFrames() {
+    EFLedIndexFrames<16> knightrider = {};
+    for (uint8_t tick = 0; tick < 16; tick++) {
+        uint16_t pattern = 0b111 << (EFLED_EFBAR_NUM - 3);
+        if (tick % 16 < 8) {
+            // Animate down
+            pattern >>= tick % 8;
+        } else {
+            // Animate up
+            pattern >>= 8 - (tick % 8);
+        }
+
+        for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
+            knightrider.frames[tick][EFLED_EFBAR_OFFSET + i] = (pattern >> i) & 0b1;
+        }
+    }
+    return knightrider;
+}
+
+/**
+ * @brief Renders the index frames of the pulse animation: Two LEDs moving from
+ * both ends of the EF bar towards its center. The center LED is only lit in
+ * the last frame. Evaluated by the compiler.
+ */
+constexpr EFLedIndexFrames<5> buildPulseFrames() {
+    EFLedIndexFrames<5> pulse = {};
+    for (uint8_t tick = 0; tick < 5; tick++) {
+        pulse.frames[tick][EFLED_EFBAR_OFFSET + tick] = 1;
+        pulse.frames[tick][EFLED_EFBAR_OFFSET + EFLED_EFBAR_NUM - 1 - tick] = 1;
+    }
+    pulse.frames[4][EFLED_EFBAR_OFFSET + EFLED_EFBAR_NUM / 2] = 1;
+    return pulse;
+}
+
+static constexpr EFLedIndexFrames<16> knightrider_frames = buildKnightRiderFrames();
+static constexpr EFLedIndexFrames<5> pulse_frames = buildPulseFrames();
 
 const char* AnimateSnake::getName() {
     return "AnimateSnake";
@@ -72,6 +136,35 @@ const unsigned int AnimateSnake::getTickRateMs() {
 
 void AnimateSnake::entry() {
     this->tick = 0;
+    this->_applyMode();
+}
+
+void AnimateSnake::_applyMode() {
+    // Pre-rendered animations are played back as index frames. Index 1 is the LED color.
+    const bool indexed = (
+        animations[this->globals->animSnakeAnimationIdx % ANIMATE_SNAKE_NUM_TOTAL].animate == &AnimateSnake::_animateKnightRider ||
+        animations[this->globals->animSnakeAnimationIdx % ANIMATE_SNAKE_NUM_TOTAL].animate == &AnimateSnake::_animatePulse
+    );
+    EFLed.setPaletteEntry(0, CRGB::Black);
+    EFLed.setPaletteEntry(1, hueList[this->globals->animSnakeHueIdx]);
+    EFLed.setIndexedMode(indexed);
+
+    snakes.clear();
+    const auto setup = animations[this->globals->animSnakeAnimationIdx % ANIMATE_SNAKE_NUM_TOTAL].setup;
+    if (setup != nullptr) {
+        (*this.*setup)();
+    }
+}
+
+void AnimateSnake::_setupSnake() {
+    snakes.add(ANIMATE_SNAKE_PATH_ALL, 64, 3, hueList[this->globals->animSnakeHueIdx], false);
+}
+
+void AnimateSnake::_setupMultiSnake() {
+    const uint8_t hue = this->globals->animSnakeHueIdx;
+    snakes.add(ANIMATE_SNAKE_PATH_DRAGON, 40, 3, hueList[hue], true);
+    snakes.add(ANIMATE_SNAKE_PATH_EFBAR, 96, 4, hueList[(hue + 1) % ANIMATE_HUE_NUM_TOTAL], true);
+    snakes.add(ANIMATE_SNAKE_PATH_EFBAR, 56, 3, hueList[(hue + 2) % ANIMATE_HUE_NUM_TOTAL], true);
 }
 
 void AnimateSnake::run() {
@@ -92,7 +185,10 @@ std::unique_ptr<FSMState> AnimateSnake::touchEventFingerprintRelease() {
     }
     this->is_globals_dirty = true;
     this->tick = 0;
+    EFLed.beginFrame();
     EFLed.clear();
+    this->_applyMode();
+    EFLed.commitFrame();
 
     LOGF_INFO(
         "(AnimateSnake) Changed animation mode to: %d\r\n",
@@ -115,52 +211,15 @@ std::unique_ptr<FSMState> AnimateSnake::touchEventFingerprintLongpress() {
 }
 
 void AnimateSnake::_animateKnightRider() {
-    // Calculate pattern
-    uint16_t pattern = 0b111 << (EFLED_EFBAR_NUM - 3);
-    if (tick % 16 < 8) {
-        // Animate down
-        pattern >>= tick % 8;
-    } else {
-        // Animate up
-        pattern >>= 8 - (tick % 8);
-    }
-
-    // Translate pattern to LED colors
-    CRGB colors[EFLED_EFBAR_NUM] = {};
-    for (uint8_t i = 0; i < EFLED_EFBAR_NUM; i++) {
-        if (pattern & 0b1) {
-            colors[i] = hueList[this->globals->animSnakeHueIdx];
-        }
-        pattern >>= 1;
-    }
-
-    // Apply
-    EFLed.setEFBar(colors);
+    EFLed.setIndexSource(knightrider_frames[this->tick]);
 }
 
 void AnimateSnake::_animateSnake() {
-    std::vector<CRGB> pattern = {
-        hueList[this->globals->animSnakeHueIdx],
-        hueList[this->globals->animSnakeHueIdx],
-        hueList[this->globals->animSnakeHueIdx],
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-    };
-
-    std::rotate(pattern.rbegin(), pattern.rbegin() + this->tick % EFLED_TOTAL_NUM, pattern.rend());
-    EFLed.setAll(pattern.data());
+    CRGB data[EFLED_TOTAL_NUM];
+    fill_solid(data, EFLED_TOTAL_NUM, CRGB::Black);
+    snakes.render(data);
+    snakes.update();
+    EFLed.setAll(data);
 }
 
 std::unique_ptr<FSMState> AnimateSnake::touchEventAllLongpress() {
@@ -169,54 +228,22 @@ std::unique_ptr<FSMState> AnimateSnake::touchEventAllLongpress() {
 }
 
 void AnimateSnake::_animatePulse() {
-
-    // Create half of the pattern
-    std::vector<CRGB> patternFirstHalf = {
-        hueList[this->globals->animSnakeHueIdx],
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-        CRGB::Black,
-    };
-    // shift the active LED
-    std::rotate(patternFirstHalf.rbegin(), patternFirstHalf.rbegin() + this->tick % 5, patternFirstHalf.rend());
-
-    // copy the pattern and flip it
-    std::vector<CRGB> patternSecondHalf = patternFirstHalf;
-    std::reverse(patternSecondHalf.begin(), patternSecondHalf.end());
-
-    // Handle the center LED. Only light it in the last part of the animation
-    if(patternSecondHalf[0] == hueList[this->globals->animSnakeHueIdx]) {
-        patternFirstHalf.insert(patternFirstHalf.end(), hueList[this->globals->animSnakeHueIdx]);
-    }else{
-        patternFirstHalf.insert(patternFirstHalf.end(), CRGB::Black);
-    }
-
-    // create the final pattern array and append the second half pattern
-    std::vector<CRGB> pattern = patternFirstHalf;
-    pattern.insert(pattern.end(), patternSecondHalf.begin(), patternSecondHalf.end());
-
-    EFLed.setEFBar(pattern.data());
+    EFLed.setIndexSource(pulse_frames[this->tick]);
 }
 
 void AnimateSnake::_animateRandom() {
 
     // set a random LED to light up
     if(tick % 2 == 0) {
-        randomLightList[random(0, EFLED_TOTAL_NUM-1)] = 255;
+        randomLightList[random(0, EFLED_TOTAL_NUM)] = 255;
     }
 
-    std::vector<CRGB> pattern;
-
     // loop through all LED brighnesses and set it. Subtract it afterward to slowly dim them
-    for(int & i : randomLightList) {
-        CHSV color = hueList[this->globals->animSnakeHueIdx];
-        color.value = i;
-        pattern.insert(pattern.end(), color);
-        i -= 20;
-        if(i < 0) { i = 0; };
+    CRGB data[EFLED_TOTAL_NUM];
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::dim(hueList[this->globals->animSnakeHueIdx], randomLightList[i]);
+        randomLightList[i] = qsub8(randomLightList[i], 20);
     }
 
-
-    EFLed.setAll(pattern.data());
+    EFLed.setAll(data);
 }
\ No newline at end of file
@@ -27,10 +27,21 @@
 #include <EFLed.h>
 #include <EFLogging.h>
 #include <EFPrideFlags.h>
-#include <vector>
+#include <iterator>
 
 #include "FSMState.h"
 
+/**
+ * @brief Number of flags. Mode 0 cycles through all flags, modes 1 - num_flags
+ * show a single flag each.
+ */
+constexpr uint8_t num_flags = std::size(EFPrideFlags::registry);
+
+/**
+ * @brief Stripe transitions for the dragon head of each flag, dimmed by half
+ */
+static constexpr EFPrideFlags::Rings<num_flags> rings = EFPrideFlags::buildRings(128);
+
 const char* DisplayPrideFlag::getName() {
     return "DisplayPrideFlag";
 }
@@ -40,7 +51,7 @@ bool DisplayPrideFlag::shouldBeRemembered() {
 }
 
 const unsigned int DisplayPrideFlag::getTickRateMs() {
-    return 20;
+    return 25;
 }
 
 void DisplayPrideFlag::entry() {
@@ -49,74 +60,31 @@ void DisplayPrideFlag::entry() {
 }
 
 void DisplayPrideFlag::run() {
+    const bool refresh = this->tick % (this->switchdelay_ms / this->getTickRateMs()) == 0;
+
     // Check if we need to switch the flag (Mode: 0)
-    if (this->tick % (this->switchdelay_ms / this->getTickRateMs()) == 0) {
-        if (this->globals->prideFlagModeIdx == 0) {
-            // Cycle through all flags
-            LOGF_DEBUG("(DisplayPrideFlag) Switched pride flag to: %d\r\n", flagidx);
-            flagidx = (flagidx + 1) % 12;
-        }
+    if (refresh && this->globals->prideFlagModeIdx == 0) {
+        flagidx = (flagidx + 1) % num_flags;
+        LOGF_DEBUG("(DisplayPrideFlag) Switched pride flag to: %s\r\n", EFPrideFlags::registry[flagidx].name);
     }
 
     // Determine pride flag to show
-    const CRGB* prideFlag = EFPrideFlags::LGBTQI;
-    if (this->globals->prideFlagModeIdx == 0) {
-        switch (flagidx) {
-            case 0: prideFlag = EFPrideFlags::LGBTQI; break;
-            case 1: prideFlag = EFPrideFlags::LGBT; break;
-            case 2: prideFlag = EFPrideFlags::Bisexual; break;
-            case 3: prideFlag = EFPrideFlags::Polyamorous; break;
-            case 4: prideFlag = EFPrideFlags::Polysexual; break;
-            case 5: prideFlag = EFPrideFlags::Transgender; break;
-            case 6: prideFlag = EFPrideFlags::Pansexual; break;
-            case 7: prideFlag = EFPrideFlags::Asexual; break;
-            case 8: prideFlag = EFPrideFlags::Genderfluid; break;
-            case 9: prideFlag = EFPrideFlags::Genderqueer; break;
-            case 10: prideFlag = EFPrideFlags::Nonbinary; break;
-            case 11: prideFlag = EFPrideFlags::Intersex; break;
-        }
-    } else {
-        switch(this->globals->prideFlagModeIdx) {
-            // Static flags
-            case 1: prideFlag = EFPrideFlags::LGBT; break;
-            case 2: prideFlag = EFPrideFlags::LGBTQI; break;
-            case 3: prideFlag = EFPrideFlags::Bisexual; break;
-            case 4: prideFlag = EFPrideFlags::Polyamorous; break;
-            case 5: prideFlag = EFPrideFlags::Polysexual; break;
-            case 6: prideFlag = EFPrideFlags::Transgender; break;
-            case 7: prideFlag = EFPrideFlags::Pansexual; break;
-            case 8: prideFlag = EFPrideFlags::Asexual; break;
-            case 9: prideFlag = EFPrideFlags::Genderfluid; break;
-            case 10: prideFlag = EFPrideFlags::Genderqueer; break;
-            case 11: prideFlag = EFPrideFlags::Nonbinary; break;
-            case 12: prideFlag = EFPrideFlags::Intersex; break;
-            default:
-                LOG_ERROR("(DisplayPrideFlag) Invalid prideFlagModeIdx!")
-                break;
-        }
-    }
-    
-    // Animate dragon: Rotate current flag to cycle through dragon head
-    std::vector<CRGB> rotatedflag(prideFlag, prideFlag + EFLED_EFBAR_NUM);
-    std::rotate(rotatedflag.begin(), rotatedflag.begin() + (this->tick % (EFLED_EFBAR_NUM*20)) / 20, rotatedflag.end());
+    const uint8_t idx = this->globals->prideFlagModeIdx == 0
+        ? flagidx
+        : (this->globals->prideFlagModeIdx - 1) % num_flags;
 
-    // Animate dragon: Create current and next dragon head patterns
+    // Animate dragon: Cycle the flag through the dragon head with smooth stripe transitions
+    const uint8_t step = this->tick % EFPRIDEFLAGS_BLEND_STEPS;
+    const uint8_t rotation = (this->tick / EFPRIDEFLAGS_BLEND_STEPS) % EFLED_EFBAR_NUM;
     CRGB dragon[EFLED_DRAGON_NUM];
-    CRGB dragon_next[EFLED_DRAGON_NUM];
-    std::copy(rotatedflag.begin(), rotatedflag.begin() + EFLED_DRAGON_NUM, dragon);
-    std::copy(rotatedflag.begin() + 1, rotatedflag.begin() + 1 + EFLED_DRAGON_NUM, dragon_next);
-
-    // Animate dragon: Blend both patterns based on current tick and reduce brightness
-    CRGB dragon_now[EFLED_DRAGON_NUM];
-    blend(dragon, dragon_next, dragon_now, EFLED_DRAGON_NUM, ((this->tick % 20) / 20.0) * 255);
-    fadeLightBy(dragon_now, EFLED_DRAGON_NUM, 128);
-
-    // Animate dragon: Finally show it!
-    EFLed.setDragon(dragon_now);
+    for (uint8_t i = 0; i < EFLED_DRAGON_NUM; i++) {
+        dragon[i] = rings[idx].get(rotation + i, step);
+    }
+    EFLed.setDragon(dragon);
 
     // Refresh flag periodically
-    if (this->tick % (this->switchdelay_ms / this->getTickRateMs()) == 0) {
-        EFLed.setEFBar(prideFlag);
+    if (refresh) {
+        EFLed.setEFBar(EFPrideFlags::registry[idx].stripes->data());
     }
 
     // Prepare next tick
@@ -140,10 +108,15 @@ std::unique_ptr<FSMState> DisplayPrideFlag::touchEventFingerprintRelease() {
         return nullptr;
     }
 
-    this->globals->prideFlagModeIdx = (this->globals->prideFlagModeIdx + 1) % 13;
+    this->globals->prideFlagModeIdx = (this->globals->prideFlagModeIdx + 1) % (1 + num_flags);
     this->is_globals_dirty = true;
     this->tick = 0;
 
+    LOGF_INFO(
+        "(DisplayPrideFlag) Changed mode to: %s\r\n",
+        this->globals->prideFlagModeIdx == 0 ? "Cycle" : EFPrideFlags::registry[this->globals->prideFlagModeIdx - 1].name
+    );
+
     return nullptr;
 }
 
@@ -29,6 +29,20 @@
 
 #include "FSMState.h"
 
+/**
+ * @brief Blinks the dragons eye three times in the given color without blocking
+ *
+ * @param color Color to blink with
+ */
+static void _blinkEye(const CRGB color) {
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::Black, 255);
+    for (uint8_t i = 0; i < 3; i ++) {
+        timeline.add(200, EFLED_MASK(EFLED_DRAGON_EYE_IDX), color);
+        timeline.add(200, EFLED_MASK_NONE, CRGB::Black);
+    }
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
+}
 
 void FSMState::attachGlobals(std::shared_ptr<FSMGlobals> globals) {
     this->globals = std::move(globals);
@@ -46,23 +60,13 @@ void FSMState::lock() {
     this->is_locked = true;
     LOG_INFO("(FSM) Locked current state");
 
-    for (uint8_t i = 0; i < 3; i ++) {
-        EFLed.setDragonEye(CRGB::Red);
-        delay(200);
-        EFLed.setDragonEye(CRGB::Black);
-        delay(200);
-    }
+    _blinkEye(CRGB::Red);
 }
 
 void FSMState::unlock() {
     this->is_locked = false;
 
-    for (uint8_t i = 0; i < 3; i ++) {
-        EFLed.setDragonEye(CRGB::Green);
-        delay(200);
-        EFLed.setDragonEye(CRGB::Black);
-        delay(200);
-    }
+    _blinkEye(CRGB::Green);
 
     LOG_INFO("(FSM) Unlocked current state")
 }
@@ -95,6 +99,8 @@ void FSMState::entry() {}
 
 void FSMState::run() {}
 
+void FSMState::render(const unsigned long t_ms, const uint8_t progress) {}
+
 void FSMState::exit() {}
 
 std::unique_ptr<FSMState> FSMState::touchEventFingerprintTouch() {
@@ -25,6 +25,7 @@
  */
 
 #include <EFLed.h>
+#include <EFLedHue.h>
 #include <EFLogging.h>
 #include "FSMState.h"
 
@@ -49,17 +50,17 @@ painlessMesh mesh;
 uint8_t rainbow[] = {1,24,47,72,96,116,140,164,186,210,232};
 
 std::vector<CRGB> bar = {
-  CHSV(rainbow[0], 255, 255),
-  CHSV(rainbow[1], 255, 255),
-  CHSV(rainbow[2], 255, 255),
-  CHSV(rainbow[3], 255, 255),
-  CHSV(rainbow[4], 255, 255),
-  CHSV(rainbow[5], 255, 255),
-  CHSV(rainbow[6], 255, 255),
-  CHSV(rainbow[7], 255, 255),
-  CHSV(rainbow[8], 255, 255),
-  CHSV(rainbow[9], 255, 255),
-  CHSV(rainbow[10], 255, 255)
+  EFLedHue::get(rainbow[0]),
+  EFLedHue::get(rainbow[1]),
+  EFLedHue::get(rainbow[2]),
+  EFLedHue::get(rainbow[3]),
+  EFLedHue::get(rainbow[4]),
+  EFLedHue::get(rainbow[5]),
+  EFLedHue::get(rainbow[6]),
+  EFLedHue::get(rainbow[7]),
+  EFLedHue::get(rainbow[8]),
+  EFLedHue::get(rainbow[9]),
+  EFLedHue::get(rainbow[10])
 };
 
 uint8_t refresh_happen = 0;
@@ -78,13 +79,13 @@ void update_bar_to_reflect_consensus(){
 		int num_leds_for_color = (int)(((float)hue_consensus[i] * 11.0f) / (float)total_sum);
 		
 		for (int j = 0; j < num_leds_for_color && ledIndex < 11; j++) {
-			bar[ledIndex] = CHSV(rainbow[i], 255, 255);
+			bar[ledIndex] = EFLedHue::get(rainbow[i]);
 			ledIndex++;
 		}
 	}
 	
 	while (ledIndex < 11) {
-		bar[ledIndex] = CHSV(0,0,0);
+		bar[ledIndex] = CRGB::Black;
 		ledIndex++;
 	}
 }
@@ -196,10 +197,10 @@ void GameHuemesh::run() {
 	mesh.update();
 
 	std::vector<CRGB> dragon = {
-	  CHSV(rainbow[own_hue], 255, 255),
-	  CHSV(rainbow[own_hue], 255, 169),
-	  CHSV(rainbow[own_hue], 255, 124),
-	  CHSV(rainbow[own_hue], 255, 100),
+	  EFLedHue::get(rainbow[own_hue]),
+	  EFLedHue::get(rainbow[own_hue], 169),
+	  EFLedHue::get(rainbow[own_hue], 124),
+	  EFLedHue::get(rainbow[own_hue], 100),
 	  CRGB::Black,
 	  CRGB::Black
 	};
@@ -209,9 +210,9 @@ void GameHuemesh::run() {
 		edit_happen++;
 	} else {
 		dragon = {
-			CHSV(rainbow[own_hue], 255, 255),
-			CHSV(rainbow[own_hue], 255, 100),
-			CHSV(rainbow[own_hue], 255, 255),
+			EFLedHue::get(rainbow[own_hue]),
+			EFLedHue::get(rainbow[own_hue], 100),
+			EFLedHue::get(rainbow[own_hue]),
 			CRGB::Black,
 			CRGB::Black,
 			CRGB::Black
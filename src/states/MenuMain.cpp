@@ -25,6 +25,7 @@
  */
 
 #include <EFLed.h>
+#include <EFLedBar.h>
 #include <EFLogging.h>
 
 #include "FSMState.h"
@@ -32,7 +33,7 @@
 /**
  * @brief Number of registered menu items
  */
-#define MENUMAIN_NUM_MENU_ITEMS 8
+#define MENUMAIN_NUM_MENU_ITEMS 9
 
 CRGB menuColors[11] = {
     CRGB(40,10,10),
@@ -91,6 +92,7 @@ std::unique_ptr<FSMState> MenuMain::touchEventFingerprintShortpress() {
 //        case 5: return std::make_unique<OTAUpdate>(); // OTA Update not in production firmware
 		case 6: return std::make_unique<GameHuemesh>(); //Game :3
 		case 7: return std::make_unique<VUMeter>(); //VUMeter :3
+        case 8: return std::make_unique<AnimatePlayer>();
         default: return nullptr;
     }
 }
@@ -100,9 +102,6 @@ std::unique_ptr<FSMState> MenuMain::touchEventFingerprintLongpress() {
 }
 
 std::unique_ptr<FSMState> MenuMain::touchEventNoseLongpress() {
-    EFLed.clear();
-    EFLed.setDragonEye(CRGB::White);
-
     uint8_t currentBrightness = this->globals->ledBrightnessPercent;
     // if we start at 10, it will be 10 -> 40 -> 70 -> 100 -> 10…
     uint8_t newBrightness =  currentBrightness + 30;
@@ -112,33 +111,30 @@ std::unique_ptr<FSMState> MenuMain::touchEventNoseLongpress() {
     }
     LOGF_DEBUG("(MenuMain) Setting brightness percent to %d\r\n", newBrightness);
 
-    // animate to new brightness
-    CRGB data[EFLED_EFBAR_NUM];
-    fill_solid(data, EFLED_EFBAR_NUM, CRGB::Black);
-    float stepSize = (newBrightness - currentBrightness) / 10.0f;
-    fill_solid(data, map(currentBrightness, 0, 100, 0, EFLED_EFBAR_NUM), CRGB(30, 30, 30));
-    EFLed.setEFBar(data);
-    delay(100);
-    fill_solid(data, map(currentBrightness, 0, 100, 0, EFLED_EFBAR_NUM), CRGB(100, 100, 100));
-    EFLed.setEFBar(data);
-    delay(200);
-    for(int8_t i = 1; i <= 10; i++) {
-        float interpolatedBrightness = currentBrightness + (i * stepSize);
-        EFLed.setBrightnessPercent(interpolatedBrightness);
-        fill_solid(data, EFLED_EFBAR_NUM, CRGB::Black);
-        fill_solid(data, map(interpolatedBrightness, 0, 100, 0, EFLED_EFBAR_NUM), CRGB(100, 100, 100));
-        EFLed.setEFBar(data);
-        delay(40);
-    }
-    fill_solid(data, map(newBrightness, 0, 100, 0, EFLED_EFBAR_NUM), CRGB(100, 100, 100));
-    EFLed.setEFBar(data);
-    delay(400);
-
+    // animate to new brightness on top of the menu, without blocking the FSM
+    const uint16_t currentLevel = EFLedBar::level(currentBrightness, 100);
+    const uint16_t newLevel = EFLedBar::level(newBrightness, 100);
+    EFLedTimeline& timeline = EFLed.getTimeline(EFLED_OVERLAY_UI);
+    timeline.reset(EFLED_MASK_ALL, CRGB::Black, 255);
+    timeline.add(0, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::White);
+    timeline.addLevel(100, currentLevel, CRGB(30, 30, 30), currentBrightness);
+    timeline.add(0, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::White);
+    timeline.addLevel(200, currentLevel, CRGB(100, 100, 100), currentBrightness);
+    timeline.add(0, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::White);
+    timeline.addLevel(400, currentLevel, CRGB(100, 100, 100), currentBrightness, true);
+    timeline.add(0, EFLED_MASK(EFLED_DRAGON_EYE_IDX), CRGB::White);
+    timeline.addLevel(400, newLevel, CRGB(100, 100, 100), newBrightness);
+    EFLed.playTimeline(EFLED_OVERLAY_UI);
+
+    // The timeline only previews the brightness. The new value stays in effect,
+    // even if the timeline is interrupted by another effect.
+    EFLed.setBrightnessPercent(newBrightness);
     this->globals->ledBrightnessPercent = newBrightness;
     this->is_globals_dirty = true;
-    EFLed.setBrightnessPercent(this->globals->ledBrightnessPercent);
 
-    // reset view
+    // reset view below the brightness animation
+    EFLed.beginFrame();
     this->entry();
+    EFLed.commitFrame();
     return nullptr;
 }
@@ -56,6 +56,7 @@ void OTAUpdate::run() {
 void OTAUpdate::exit() {
     EFBoard.disableOTA();
     EFBoard.disableWifi();
+    EFLed.clearOverlay(EFLED_OVERLAY_STATUS);
 }
 
 std::unique_ptr<FSMState> OTAUpdate::touchEventFingerprintShortpress() {
@@ -25,15 +25,25 @@
  */
 
 #include <EFLed.h>
+#include <EFLedHue.h>
 #include <EFLogging.h>
 
 #include "FSMState.h"
 
 #define AUDIO_PIN 14
 
-const int hue_list[] = {
-110,110,110,110,110,110,110,110,110,110,110
-};
+constexpr EFLedColors<EFLED_EFBAR_NUM> bar_colors = {{
+    EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255),
+    EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255),
+    EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255),
+    EFLedColor::hsv2rgb(110, 255, 255), EFLedColor::hsv2rgb(110, 255, 255),
+}};
+
+constexpr EFLedColors<3> dragon_colors = {{
+    EFLedColor::hsv2rgb(0, 255, 40),
+    EFLedColor::hsv2rgb(0, 255, 110),
+    EFLedColor::hsv2rgb(0, 255, 255),
+}};
 
 const char* VUMeter::getName() {
     return "VUMeter";
@@ -72,26 +82,18 @@ void VUMeter::run() {
 
     std::vector<CRGB> dragon = {
         CRGB::Black,
-        CHSV(0, 255, 40),
-        CHSV(0, 255, 110),
-        CHSV(0, 255, 255),
+        dragon_colors[0],
+        dragon_colors[1],
+        dragon_colors[2],
         CRGB::Black,
         CRGB::Black
     };
 
-    std::vector<CRGB> bar = {
-        CHSV(hue_list[0], 255, (n > 0 ? 0 : 255)),
-        CHSV(hue_list[1], 255, (n > 1 ? 0 : 255)),
-        CHSV(hue_list[2], 255, (n > 2 ? 0 : 255)),
-        CHSV(hue_list[3], 255, (n > 3 ? 0 : 255)),
-        CHSV(hue_list[4], 255, (n > 4 ? 0 : 255)),
-        CHSV(hue_list[5], 255, (n > 5 ? 0 : 255)),
-        CHSV(hue_list[6], 255, (n > 6 ? 0 : 255)),
-        CHSV(hue_list[7], 255, (n > 7 ? 0 : 255)),
-        CHSV(hue_list[8], 255, (n > 8 ? 0 : 255)),
-        CHSV(hue_list[9], 255, (n > 9 ? 0 : 255)),
-        CHSV(hue_list[10], 255, (n > 10 ? 0 : 255)),
-    };
+    // Light up the bar above the current signal strength
+    std::vector<CRGB> bar(EFLED_EFBAR_NUM, CRGB::Black);
+    for (uint8_t i = n; i < EFLED_EFBAR_NUM; i++) {
+        bar[i] = bar_colors[i];
+    }
 
     // Calculate current pattern based on tick
     std::rotate(dragon.begin(), dragon.begin() + this->tick % EFLED_DRAGON_NUM, dragon.end());
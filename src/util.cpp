@@ -45,15 +45,3 @@ const char* toString(EFTouchZone zone) {
         default: return "INVALID";
     }
 }
-
-/**
- * @brief Calculates a wave animation. Used by bootupAnimation()
- */
-const float wave_function(float x, float start, float end, float amplitude) {
-    if (x < start || x > end) {
-        return 0;
-    }
-    double normalized_x = (x - start) / (end - start) * M_PI;
-    return amplitude * std::sin(normalized_x);
-}
-
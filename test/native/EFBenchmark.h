@@ -0,0 +1,104 @@
+#ifndef EFBENCHMARK_H_
+#define EFBENCHMARK_H_
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define EFBENCHMARK_UNIT "cycles"
+#else
+#define EFBENCHMARK_UNIT "ns"
+#endif
+
+/**
+ * @brief Minimal micro benchmark for the native test environment. Host numbers
+ * are not the numbers of the badge, but the ratio between two implementations
+ * of the same frame is a good indicator.
+ */
+class EFBenchmark {
+
+    public:
+
+        /**
+         * @brief Keeps the compiler from optimizing away work whose result is
+         * only written to memory
+         */
+        static inline void clobber(const void* ptr) {
+            asm volatile("" : : "r"(ptr) : "memory");
+        }
+
+        /**
+         * @brief Runs the given frame repeatedly and returns the average cost of a
+         * single frame in EFBENCHMARK_UNIT
+         *
+         * @param frame Callable rendering a single frame
+         * @param iterations Number of frames to measure
+         */
+        template<typename F>
+        static double perFrame(F frame, const uint32_t iterations = 100000) {
+            for (uint32_t i = 0; i < iterations / 10; i++) {
+                frame(i);
+            }
+
+            const uint64_t start = now();
+            for (uint32_t i = 0; i < iterations; i++) {
+                frame(i);
+            }
+            return static_cast<double>(now() - start) / iterations;
+        }
+
+        /**
+         * @brief Prints a single benchmark result to stdout
+         *
+         * @param name Name of the measured frame
+         * @param value Result of perFrame()
+         */
+        static void report(const char* name, const double value) {
+            printf("%-32s %8.1f " EFBENCHMARK_UNIT "/frame\n", name, value);
+        }
+
+    private:
+
+        static inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+#endif
+        }
+
+};
+
+#endif /* EFBENCHMARK_H_ */
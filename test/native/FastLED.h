@@ -0,0 +1,149 @@
+#ifndef FASTLED_H
+#define FASTLED_H
+
+
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+// Host stand-in for the parts of FastLED used by the code under test. The
+// formulas follow FastLED 3.7 with its default FASTLED_SCALE8_FIXED and
+// FASTLED_BLEND_FIXED, so results are bit-exact to the firmware.
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(const uint8_t i, const fract8 scale) {
+    return (static_cast<uint16_t>(i) * (1 + static_cast<uint16_t>(scale))) >> 8;
+}
+
+inline uint8_t scale8_video(const uint8_t i, const fract8 scale) {
+    return ((i * scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(const uint8_t i, const uint8_t j) {
+    const uint16_t t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(const uint8_t i, const uint8_t j) {
+    return i > j ? i - j : 0;
+}
+
+inline uint8_t blend8(const uint8_t a, const uint8_t b, const uint8_t amount) {
+    uint16_t partial = (a << 8) | b;
+    partial += b * amount;
+    partial -= a * amount;
+    return partial >> 8;
+}
+
+struct CRGB {
+    union {
+        struct {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    CRGB() = default;
+
+    constexpr CRGB(const uint8_t ir, const uint8_t ig, const uint8_t ib) : r(ir), g(ig), b(ib) {}
+
+    constexpr CRGB(const uint32_t colorcode)
+    : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+
+    CRGB& operator+=(const CRGB& rhs) {
+        this->r = qadd8(this->r, rhs.r);
+        this->g = qadd8(this->g, rhs.g);
+        this->b = qadd8(this->b, rhs.b);
+        return *this;
+    }
+
+    CRGB& operator|=(const CRGB& rhs) {
+        this->r = this->r > rhs.r ? this->r : rhs.r;
+        this->g = this->g > rhs.g ? this->g : rhs.g;
+        this->b = this->b > rhs.b ? this->b : rhs.b;
+        return *this;
+    }
+
+    CRGB& nscale8(const uint8_t scale) {
+        this->r = ::scale8(this->r, scale);
+        this->g = ::scale8(this->g, scale);
+        this->b = ::scale8(this->b, scale);
+        return *this;
+    }
+
+    CRGB scale8(const uint8_t scale) const {
+        return CRGB(::scale8(this->r, scale), ::scale8(this->g, scale), ::scale8(this->b, scale));
+    }
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Red = 0xFF0000,
+        Green = 0x008000,
+        Blue = 0x0000FF,
+        White = 0xFFFFFF,
+    };
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs) {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs) {
+    return !(lhs == rhs);
+}
+
+inline CRGB& nblend(CRGB& existing, const CRGB& overlay, const fract8 amount) {
+    if (amount == 0) {
+        return existing;
+    }
+    if (amount == 255) {
+        existing = overlay;
+        return existing;
+    }
+    existing.r = blend8(existing.r, overlay.r, amount);
+    existing.g = blend8(existing.g, overlay.g, amount);
+    existing.b = blend8(existing.b, overlay.b, amount);
+    return existing;
+}
+
+inline CRGB blend(const CRGB& p1, const CRGB& p2, const fract8 amount) {
+    CRGB result = p1;
+    nblend(result, p2, amount);
+    return result;
+}
+
+inline void fill_solid(CRGB* leds, const int num, const CRGB& color) {
+    for (int i = 0; i < num; i++) {
+        leds[i] = color;
+    }
+}
+
+#endif /* FASTLED_H */
@@ -0,0 +1,167 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+
+#include <stdlib.h>
+
+#include <new>
+
+#include <unity.h>
+
+#include <EFLedParticles.h>
+#include <EFLedPaths.h>
+#include <EFLedSnakes.h>
+
+#define FRAMES 10000  //!< Number of frames rendered per test
+
+namespace {
+
+size_t allocations = 0;
+
+constexpr EFLedPath snake_paths[] = {
+    {EFLedPaths::all, EFLED_TOTAL_NUM},
+    {EFLedPaths::dragon_outline, EFLED_DRAGON_NUM},
+    {EFLedPaths::efbar_down, EFLED_EFBAR_NUM},
+};
+
+}
+
+// Count every heap allocation made while the tests run
+
+void* operator new(size_t size) {
+    allocations++;
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void setUp() {
+    allocations = 0;
+}
+
+void tearDown() {}
+
+void test_snakes_render_without_allocations() {
+    // Same setup as the multi snake mode of AnimateSnake
+    static EFLedSnakes<3> snakes(snake_paths, 3);
+    CRGB leds[EFLED_TOTAL_NUM];
+
+    TEST_ASSERT_TRUE(snakes.add(1, 40, 3, CRGB::Red, true));
+    TEST_ASSERT_TRUE(snakes.add(2, 96, 4, CRGB::Green, true));
+    TEST_ASSERT_TRUE(snakes.add(2, 56, 3, CRGB::Blue, true));
+    TEST_ASSERT_FALSE(snakes.add(0, 64, 3, CRGB::White, false));
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        fill_solid(leds, EFLED_TOTAL_NUM, CRGB::Black);
+        snakes.update();
+        snakes.render(leds);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+}
+
+void test_snake_length() {
+    static EFLedSnakes<1> snakes(snake_paths, 3);
+    CRGB leds[EFLED_TOTAL_NUM];
+
+    // A snake moving exactly one LED per update lights exactly its length
+    snakes.add(0, 256, 3, CRGB::White, false);
+    for (uint32_t frame = 0; frame < 2 * EFLED_TOTAL_NUM; frame++) {
+        fill_solid(leds, EFLED_TOTAL_NUM, CRGB::Black);
+        snakes.update();
+        snakes.render(leds);
+
+        uint8_t lit = 0;
+        for (const CRGB& led : leds) {
+            lit += led != CRGB(CRGB::Black);
+        }
+        TEST_ASSERT_EQUAL_UINT8(3, lit);
+    }
+}
+
+void test_particles_update_without_allocations() {
+    // Same pool size as AnimateMatrix
+    static EFLedParticles<16> drops(EFLedPaths::falling, 2);
+    uint32_t sum = 0;
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        if (frame % 3 == 0) {
+            drops.spawn(frame % 2, 64 + frame % 128, 255, frame % 16);
+        }
+        drops.update(200);
+        for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+            sum += drops.getIntensity(i);
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(drops.capacity(), drops.count());
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, sum);
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+}
+
+void test_particles_leave_path() {
+    static EFLedParticles<1> drops(EFLedPaths::falling, 2);
+
+    TEST_ASSERT_TRUE(drops.spawn(0, 256, 255, 0));
+    TEST_ASSERT_FALSE(drops.spawn(1, 256, 255, 0));
+    for (uint8_t i = 0; i < EFLED_DRAGON_NUM; i++) {
+        TEST_ASSERT_EQUAL_UINT32(1, drops.count());
+        drops.update(0);
+        TEST_ASSERT_EQUAL_UINT8(255, drops.getIntensity(EFLedPaths::dragon_down[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, drops.count());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_snakes_render_without_allocations);
+    RUN_TEST(test_snake_length);
+    RUN_TEST(test_particles_update_without_allocations);
+    RUN_TEST(test_particles_leave_path);
+    return UNITY_END();
+}
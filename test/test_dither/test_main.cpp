@@ -0,0 +1,165 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <string.h>
+
+#include <unity.h>
+
+#include <EFLedDither.h>
+
+// EFLed is excluded from the native build, since it depends on the ESP32.
+// Compile the hardware independent parts under test directly.
+#include <EFLedDither.cpp>
+#include <EFLedKernels.cpp>
+
+#define SCALE_HALF 0x8000  //!< Brightness scale that halves every linear value
+#define FRAMES 1000        //!< Number of frames a static screen is presented for (10 s at 100 Hz)
+
+namespace {
+
+uint16_t linear[EFLED_TOTAL_NUM][3];
+
+/**
+ * @brief Sets all channels to the same linear value
+ */
+void fill(const uint16_t value) {
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            linear[i][c] = value;
+        }
+    }
+}
+
+}
+
+void setUp() {
+    memset(linear, 0, sizeof(linear));
+}
+
+void tearDown() {}
+
+void test_static_frame_settles() {
+    // Lit frame with fractional levels on every channel, as with the nominal brightness
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            linear[i][c] = 0x0180 + i * 0x0B3D + c * 0x2A11;
+        }
+    }
+
+    // Mirror the skip logic of EFLedClass::present()
+    EFLedDither dither;
+    CRGB front[EFLED_TOTAL_NUM];
+    uint32_t sent = 0;
+    uint32_t last_sent = 0;
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        const bool unchanged = frame > 0;
+        if (unchanged && !dither.isPending()) {
+            continue;
+        }
+
+        CRGB out[EFLED_TOTAL_NUM];
+        dither.apply(linear, 45 * 257, unchanged, out);
+        if (frame == 0 || memcmp(front, out, sizeof(out)) != 0) {
+            memcpy(front, out, sizeof(out));
+            sent++;
+            last_sent = frame;
+        }
+    }
+
+    TEST_ASSERT_FALSE(dither.isPending());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(EFLED_DITHER_SETTLE_FRAMES + 1, sent);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(EFLED_DITHER_SETTLE_FRAMES, last_sent);
+}
+
+void test_dim_levels_preserved() {
+    // 10.5 levels alternate between 10 and 11 while dithering
+    fill(0x1500);
+
+    EFLedDither dither;
+    CRGB out[EFLED_TOTAL_NUM];
+    uint32_t sum = 0;
+    for (uint8_t frame = 0; frame < 40; frame++) {
+        dither.apply(linear, SCALE_HALF, frame > 0, out);
+        TEST_ASSERT_TRUE(dither.isPending());
+        sum += out[0].r;
+    }
+    TEST_ASSERT_EQUAL_UINT32(420, sum);
+
+    // Afterwards, the frame settles to the rounded level
+    for (uint8_t frame = 0; frame < EFLED_DITHER_SETTLE_FRAMES; frame++) {
+        dither.apply(linear, SCALE_HALF, true, out);
+    }
+    TEST_ASSERT_FALSE(dither.isPending());
+    TEST_ASSERT_EQUAL_UINT8(11, out[0].r);
+    TEST_ASSERT_EQUAL_UINT8(11, out[EFLED_TOTAL_NUM - 1].b);
+}
+
+void test_bright_channels_rounded() {
+    EFLedDither dither;
+    CRGB out[EFLED_TOTAL_NUM];
+
+    // 100.25 levels are above EFLED_DITHER_MAX_LEVEL and never dithered
+    fill(0xC880);
+    dither.apply(linear, SCALE_HALF, false, out);
+    TEST_ASSERT_FALSE(dither.isPending());
+    TEST_ASSERT_EQUAL_UINT8(100, out[0].r);
+
+    fill(0xFFFF);
+    dither.apply(linear, 0xFFFF, false, out);
+    TEST_ASSERT_EQUAL_UINT8(255, out[0].r);
+
+    fill(0);
+    dither.apply(linear, 0xFFFF, false, out);
+    TEST_ASSERT_FALSE(dither.isPending());
+    TEST_ASSERT_EQUAL_UINT8(0, out[0].r);
+}
+
+void test_change_restarts_dithering() {
+    fill(0x1500);
+
+    EFLedDither dither;
+    CRGB out[EFLED_TOTAL_NUM];
+    for (uint8_t frame = 0; frame <= EFLED_DITHER_SETTLE_FRAMES; frame++) {
+        dither.apply(linear, SCALE_HALF, frame > 0, out);
+    }
+    TEST_ASSERT_FALSE(dither.isPending());
+
+    fill(0x0F00);
+    dither.apply(linear, SCALE_HALF, false, out);
+    TEST_ASSERT_TRUE(dither.isPending());
+
+    dither.reset();
+    TEST_ASSERT_FALSE(dither.isPending());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_static_frame_settles);
+    RUN_TEST(test_dim_levels_preserved);
+    RUN_TEST(test_bright_channels_rounded);
+    RUN_TEST(test_change_restarts_dithering);
+    return UNITY_END();
+}
@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <math.h>
+
+#include <unity.h>
+
+#include <EFBenchmark.h>
+#include <EFLedHue.h>
+#include <EFLedPulse.h>
+
+// EFLed is excluded from the native build, since it depends on the ESP32.
+// Compile the hardware independent parts under test directly.
+#include <EFLedHue.cpp>
+
+#define FRAME_MS 60        //!< Frame interval of the former tick based implementation
+#define PERIOD_MS 4800     //!< Same as ANIMATE_HEARTBEAT_PERIOD_MS
+#define WAVELENGTH_MM 160  //!< Same as ANIMATE_HEARTBEAT_WAVELENGTH_MM
+#define HUE 160
+
+namespace {
+
+constexpr uint8_t origins[3] = {
+    EFLED_DRAGON_EYE_IDX,
+    EFLED_DRAGON_NOSE_IDX,
+    EFLED_DRAGON_EAR_TOP_IDX,
+};
+
+constexpr EFLedWaveform sine_wave = EFLedWaveform::sine();
+constexpr EFLedWaveform lubdub_wave = EFLedWaveform::lubDub();
+constexpr auto pulse = EFLedPulse<3>::build(origins, WAVELENGTH_MM);
+
+/**
+ * @brief Intensity of an LED in the former AnimateHeartbeat::run(), using float math
+ */
+uint8_t floatValue(const uint32_t tick, const uint8_t i) {
+    float distance = EFLedGeometry::pairwise[EFLED_DRAGON_EYE_IDX][i] / (float) (1 << EFLED_GEOMETRY_DIST_SHIFT);
+
+    // LEDs further away from the eye lag behind
+    float t = tick / 40.0 - distance / 80.0;
+
+    float intensity = sin(t * 1.0 * M_PI);
+    intensity = intensity < 0.0 ? 0.0 : intensity;
+
+    return static_cast<uint8_t>(intensity * 255);
+}
+
+/**
+ * @brief Frame of the former AnimateHeartbeat::run()
+ */
+void renderFloat(const uint32_t tick, CRGB* data) {
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::get(HUE, floatValue(tick, i));
+    }
+}
+
+/**
+ * @brief Frame of AnimateHeartbeat::render()
+ */
+void renderTable(const uint16_t phase, const uint8_t mask, CRGB* data) {
+    uint8_t values[EFLED_TOTAL_NUM];
+    pulse.render(sine_wave, mask, phase, values);
+    for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+        data[i] = EFLedHue::get(HUE, values[i]);
+    }
+}
+
+/**
+ * @brief Phase of the beat after the given number of former ticks
+ */
+uint16_t phaseOfTick(const uint32_t tick) {
+    // One tick was FRAME_MS at the slowest speed
+    const uint32_t step = (uint32_t) ((1ULL << 32) / PERIOD_MS);
+    return (tick * FRAME_MS * step) >> 16;
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_waveforms() {
+    TEST_ASSERT_EQUAL_UINT8(0, sine_wave.v[0]);
+    TEST_ASSERT_EQUAL_UINT8(255, sine_wave.v[64]);
+    for (uint16_t i = 128; i < 256; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, sine_wave.v[i]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(255, lubdub_wave.v[28]);
+    TEST_ASSERT_EQUAL_UINT8(153, lubdub_wave.v[88]);
+    for (uint16_t i = 112; i < 256; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, lubdub_wave.v[i]);
+    }
+}
+
+void test_matches_float() {
+    // The single origin sine mode reproduces the former float animation
+    for (uint32_t tick = 0; tick < 4 * 80; tick++) {
+        uint8_t values[EFLED_TOTAL_NUM];
+        pulse.render(sine_wave, 0b001, phaseOfTick(tick), values);
+        for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+            TEST_ASSERT_LESS_OR_EQUAL_INT(1, abs(floatValue(tick, i) - values[i]));
+        }
+    }
+}
+
+void test_origins_combine() {
+    // All origins together are at least as bright as every single one
+    for (uint32_t phase = 0; phase < 65536; phase += 97) {
+        uint8_t all[EFLED_TOTAL_NUM];
+        pulse.render(lubdub_wave, 0b111, phase, all);
+        for (uint8_t o = 0; o < 3; o++) {
+            uint8_t single[EFLED_TOTAL_NUM];
+            pulse.render(lubdub_wave, 1 << o, phase, single);
+            for (uint8_t i = 0; i < EFLED_TOTAL_NUM; i++) {
+                TEST_ASSERT_TRUE(all[i] >= single[i]);
+            }
+            TEST_ASSERT_EQUAL_UINT8(lubdub_wave.sample(phase), single[origins[o]]);
+        }
+    }
+}
+
+void test_benchmark() {
+    CRGB data[EFLED_TOTAL_NUM];
+
+    EFBenchmark::report("heartbeat (float)", EFBenchmark::perFrame([&](uint32_t i) {
+        renderFloat(i, data);
+        EFBenchmark::clobber(data);
+    }));
+    EFBenchmark::report("heartbeat (tables, 1 origin)", EFBenchmark::perFrame([&](uint32_t i) {
+        renderTable(phaseOfTick(i), 0b001, data);
+        EFBenchmark::clobber(data);
+    }));
+    EFBenchmark::report("heartbeat (tables, 3 origins)", EFBenchmark::perFrame([&](uint32_t i) {
+        renderTable(phaseOfTick(i), 0b111, data);
+        EFBenchmark::clobber(data);
+    }));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_waveforms);
+    RUN_TEST(test_matches_float);
+    RUN_TEST(test_origins_combine);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
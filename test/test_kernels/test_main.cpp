@@ -0,0 +1,398 @@
+// MIT License
+//
+// Copyright 2024 Eurofurence e.V. 
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the “Software”),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+/**
+ * @author Honigeintopf
+ */
+
+#include <string.h>
+
+#include <unity.h>
+
+#include <EFBenchmark.h>
+#include <EFLedKernels.h>
+
+// EFLed is excluded from the native build, since it depends on the ESP32.
+// Compile the hardware independent parts under test directly.
+#include <EFLedKernels.cpp>
+
+#define NUM_MAX 24          //!< Largest number of LEDs tested; more than the badge has
+#define ITERATIONS 2000     //!< Random rounds per test
+#define NUM_BADGE 17        //!< Number of LEDs on the badge, for the benchmark
+
+namespace {
+
+uint32_t rng_state = 0xEF28BADE;
+
+uint8_t random8() {
+    // xorshift32, so failures are reproducible
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state >> 24;
+}
+
+void randomize(uint8_t* data, const size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = random8();
+    }
+}
+
+uint8_t randomAmount() {
+    // Make sure both ends are hit regularly
+    switch (random8() & 7) {
+        case 0: return 0;
+        case 1: return 255;
+        default: return random8();
+    }
+}
+
+/**
+ * @brief Byte buffers with room to place arrays at every alignment
+ */
+struct Buffers {
+    alignas(4) uint8_t a[NUM_MAX * 3 + 4];
+    alignas(4) uint8_t b[NUM_MAX * 3 + 4];
+    alignas(4) uint8_t out[NUM_MAX * 3 + 4];
+    alignas(4) uint8_t expected[NUM_MAX * 3 + 4];
+    uint8_t alpha[NUM_MAX];
+};
+
+CRGB* leds(uint8_t* data, const size_t offset) {
+    return reinterpret_cast<CRGB*>(data + offset);
+}
+
+}
+
+void setUp() {
+    rng_state = 0xEF28BADE;
+}
+
+void tearDown() {}
+
+void test_blend_matches_reference() {
+    Buffers buf;
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t num = random8() % (NUM_MAX + 1);
+        const size_t len = num * 3;
+        const uint8_t amount = randomAmount();
+        // Cover the SWAR path (all aligned) as well as every mixed alignment
+        const size_t off_a = random8() & 3;
+        const size_t off_b = (i & 1) ? off_a : random8() & 3;
+        const size_t off_out = (i & 2) ? off_a : random8() & 3;
+
+        randomize(buf.a, sizeof(buf.a));
+        randomize(buf.b, sizeof(buf.b));
+        randomize(buf.out, sizeof(buf.out));
+        memcpy(buf.expected, buf.out, sizeof(buf.out));
+
+        EFLedKernels::Reference::blend(buf.a + off_a, buf.b + off_b, buf.expected + off_out, len, amount);
+        EFLedKernels::blend(leds(buf.a, off_a), leds(buf.b, off_b), leds(buf.out, off_out), num, amount);
+        TEST_ASSERT_EQUAL_MEMORY(buf.expected, buf.out, sizeof(buf.out));
+
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(blend8(buf.a[off_a + c], buf.b[off_b + c], amount), buf.out[off_out + c]);
+        }
+    }
+}
+
+void test_blend_aliasing() {
+    Buffers buf;
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t num = random8() % (NUM_MAX + 1);
+        const uint8_t amount = randomAmount();
+        const size_t off = random8() & 3;
+
+        randomize(buf.a, sizeof(buf.a));
+        randomize(buf.b, sizeof(buf.b));
+        EFLedKernels::Reference::blend(buf.a + off, buf.b + off, buf.expected + off, num * 3, amount);
+
+        // Output is the first input, like the crossfade in EFLedClass::_composite()
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::blend(leds(buf.out, off), leds(buf.b, off), leds(buf.out, off), num, amount);
+        TEST_ASSERT_EQUAL_MEMORY(buf.expected + off, buf.out + off, num * 3);
+
+        // Output is the second input
+        memcpy(buf.out, buf.b, sizeof(buf.b));
+        EFLedKernels::blend(leds(buf.a, off), leds(buf.out, off), leds(buf.out, off), num, amount);
+        TEST_ASSERT_EQUAL_MEMORY(buf.expected + off, buf.out + off, num * 3);
+    }
+}
+
+void test_blend_bounds() {
+    Buffers buf;
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t off = (i & 1) ? 0 : random8() & 3;
+        randomize(buf.a, sizeof(buf.a));
+        randomize(buf.b, sizeof(buf.b));
+
+        EFLedKernels::blend(leds(buf.a, off), leds(buf.b, off), leds(buf.out, off), NUM_MAX, 0);
+        TEST_ASSERT_EQUAL_MEMORY(buf.a + off, buf.out + off, NUM_MAX * 3);
+
+        EFLedKernels::blend(leds(buf.a, off), leds(buf.b, off), leds(buf.out, off), NUM_MAX, 255);
+        TEST_ASSERT_EQUAL_MEMORY(buf.b + off, buf.out + off, NUM_MAX * 3);
+    }
+}
+
+void test_uniform_kernels() {
+    Buffers buf;
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t num = random8() % (NUM_MAX + 1);
+        const size_t len = num * 3;
+        const uint8_t amount = randomAmount();
+        // Cover the SWAR path (all aligned) as well as mixed alignments
+        const size_t off = (i & 1) ? 0 : random8() & 3;
+        const size_t off_b = (i & 2) ? off : random8() & 3;
+
+        randomize(buf.a, sizeof(buf.a));
+        randomize(buf.b, sizeof(buf.b));
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::scale(leds(buf.out, off), num, amount);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(scale8(buf.a[off + c], amount), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::scaleVideo(leds(buf.out, off), num, amount);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(scale8_video(buf.a[off + c], amount), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::fadeToBlackBy(leds(buf.out, off), num, amount);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(scale8(buf.a[off + c], 255 - amount), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::fadeLightBy(leds(buf.out, off), num, amount);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(scale8_video(buf.a[off + c], 255 - amount), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::add(leds(buf.out, off), leds(buf.b, off_b), num);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(qadd8(buf.a[off + c], buf.b[off_b + c]), buf.out[off + c]);
+        }
+
+        // Channels past the end are never touched
+        TEST_ASSERT_EQUAL_MEMORY(buf.a + off + len, buf.out + off + len, sizeof(buf.a) - off - len);
+    }
+}
+
+void test_linear_kernels() {
+    alignas(4) uint16_t data[NUM_MAX * 3 + 2];
+    alignas(4) uint16_t out[NUM_MAX * 3 + 2];
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t len = random8() % (NUM_MAX * 3 + 1);
+        // Odd offsets start on a half word and take the scalar path
+        const size_t off = random8() & 1;
+        const uint16_t scale = (random8() << 8) | random8();
+
+        uint32_t expected = 0;
+        for (size_t c = 0; c < len + off; c++) {
+            data[c] = (i & 7) == 0 ? 0xFFFF : (random8() << 8) | random8();
+            expected += c >= off ? data[c] : 0;
+        }
+        TEST_ASSERT_EQUAL_UINT32(expected, EFLedKernels::sum16(data + off, len));
+        TEST_ASSERT_EQUAL_UINT32(expected, EFLedKernels::Reference::sum16(data + off, len));
+
+        EFLedKernels::scale16(data + off, out + off, len, scale);
+        for (size_t c = off; c < len + off; c++) {
+            TEST_ASSERT_EQUAL_UINT32(((uint32_t) data[c] * scale) >> 16, out[c]);
+        }
+
+        // Scaling in place
+        EFLedKernels::scale16(data + off, data + off, len, scale);
+        TEST_ASSERT_EQUAL_MEMORY(out + off, data + off, len * sizeof(uint16_t));
+    }
+}
+
+void test_alpha_kernels() {
+    Buffers buf;
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const size_t num = random8() % (NUM_MAX + 1);
+        const size_t len = num * 3;
+        const size_t off = random8() & 3;
+
+        randomize(buf.a, sizeof(buf.a));
+        randomize(buf.b, sizeof(buf.b));
+        for (size_t n = 0; n < num; n++) {
+            buf.alpha[n] = randomAmount();
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::blendAlpha(leds(buf.out, off), leds(buf.b, off), buf.alpha, num);
+        for (size_t c = 0; c < len; c++) {
+            TEST_ASSERT_EQUAL_UINT8(blend8(buf.a[off + c], buf.b[off + c], buf.alpha[c / 3]), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::addAlpha(leds(buf.out, off), leds(buf.b, off), buf.alpha, num);
+        for (size_t c = 0; c < len; c++) {
+            const uint8_t alpha = buf.alpha[c / 3];
+            TEST_ASSERT_EQUAL_UINT8(qadd8(buf.a[off + c], scale8(buf.b[off + c], alpha)), buf.out[off + c]);
+        }
+
+        memcpy(buf.out, buf.a, sizeof(buf.a));
+        EFLedKernels::multiplyAlpha(leds(buf.out, off), leds(buf.b, off), buf.alpha, num);
+        for (size_t c = 0; c < len; c++) {
+            const uint8_t alpha = buf.alpha[c / 3];
+            TEST_ASSERT_EQUAL_UINT8(scale8(buf.a[off + c], blend8(255, buf.b[off + c], alpha)), buf.out[off + c]);
+        }
+    }
+}
+
+void test_alpha_kernels_bounds() {
+    Buffers buf;
+
+    randomize(buf.a, sizeof(buf.a));
+    randomize(buf.b, sizeof(buf.b));
+
+    // Alpha 0 leaves every kernel without effect
+    memset(buf.alpha, 0, sizeof(buf.alpha));
+    memcpy(buf.out, buf.a, sizeof(buf.a));
+    EFLedKernels::blendAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    EFLedKernels::addAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    EFLedKernels::multiplyAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    TEST_ASSERT_EQUAL_MEMORY(buf.a, buf.out, NUM_MAX * 3);
+
+    // Alpha 255 applies the full operation
+    memset(buf.alpha, 255, sizeof(buf.alpha));
+    memcpy(buf.out, buf.a, sizeof(buf.a));
+    EFLedKernels::blendAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    TEST_ASSERT_EQUAL_MEMORY(buf.b, buf.out, NUM_MAX * 3);
+
+    memcpy(buf.out, buf.a, sizeof(buf.a));
+    EFLedKernels::addAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    for (size_t c = 0; c < NUM_MAX * 3; c++) {
+        TEST_ASSERT_EQUAL_UINT8(qadd8(buf.a[c], buf.b[c]), buf.out[c]);
+    }
+
+    memcpy(buf.out, buf.a, sizeof(buf.a));
+    EFLedKernels::multiplyAlpha(leds(buf.out, 0), leds(buf.b, 0), buf.alpha, NUM_MAX);
+    for (size_t c = 0; c < NUM_MAX * 3; c++) {
+        TEST_ASSERT_EQUAL_UINT8(scale8(buf.a[c], buf.b[c]), buf.out[c]);
+    }
+}
+
+void test_fastled_semantics() {
+    // The kernels rely on these properties of scale8() and blend8()
+    for (uint16_t x = 0; x < 256; x++) {
+        TEST_ASSERT_EQUAL_UINT8(0, scale8(x, 0));
+        TEST_ASSERT_EQUAL_UINT8(x, scale8(x, 255));
+        for (uint16_t y = 0; y < 256; y++) {
+            TEST_ASSERT_EQUAL_UINT8(x, blend8(x, y, 0));
+            TEST_ASSERT_EQUAL_UINT8(y, blend8(x, y, 255));
+        }
+    }
+}
+
+void test_benchmark() {
+    alignas(4) CRGB a[NUM_BADGE];
+    alignas(4) CRGB b[NUM_BADGE];
+    alignas(4) CRGB out[NUM_BADGE];
+    uint8_t alpha[NUM_BADGE];
+    randomize(reinterpret_cast<uint8_t*>(a), sizeof(a));
+    randomize(reinterpret_cast<uint8_t*>(b), sizeof(b));
+    randomize(alpha, sizeof(alpha));
+    alignas(4) uint16_t linear[NUM_BADGE * 3];
+    alignas(4) uint16_t scaled[NUM_BADGE * 3];
+    randomize(reinterpret_cast<uint8_t*>(linear), sizeof(linear));
+    uint32_t channel_sum = 0;
+
+    EFBenchmark::report("blend (scalar)", EFBenchmark::perFrame([&](uint32_t i) {
+        EFLedKernels::Reference::blend(
+            reinterpret_cast<uint8_t*>(a), reinterpret_cast<uint8_t*>(b), reinterpret_cast<uint8_t*>(out),
+            sizeof(out), i
+        );
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("blend (SWAR)", EFBenchmark::perFrame([&](uint32_t i) {
+        EFLedKernels::blend(a, b, out, NUM_BADGE, i);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("scale (scalar)", EFBenchmark::perFrame([&](uint32_t i) {
+        EFLedKernels::Reference::scale(reinterpret_cast<uint8_t*>(out), sizeof(out), i | 0x80);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("scale (SWAR)", EFBenchmark::perFrame([&](uint32_t i) {
+        EFLedKernels::scale(out, NUM_BADGE, i | 0x80);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("add (scalar)", EFBenchmark::perFrame([&](uint32_t) {
+        EFLedKernels::Reference::add(reinterpret_cast<uint8_t*>(out), reinterpret_cast<uint8_t*>(b), sizeof(out));
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("add (SWAR)", EFBenchmark::perFrame([&](uint32_t) {
+        EFLedKernels::add(out, b, NUM_BADGE);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("sum16 (scalar)", EFBenchmark::perFrame([&](uint32_t) {
+        EFBenchmark::clobber(linear);
+        channel_sum = EFLedKernels::Reference::sum16(linear, NUM_BADGE * 3);
+        EFBenchmark::clobber(&channel_sum);
+    }));
+    EFBenchmark::report("sum16 (SWAR)", EFBenchmark::perFrame([&](uint32_t) {
+        EFBenchmark::clobber(linear);
+        channel_sum = EFLedKernels::sum16(linear, NUM_BADGE * 3);
+        EFBenchmark::clobber(&channel_sum);
+    }));
+    EFBenchmark::report("scale16", EFBenchmark::perFrame([&](uint32_t i) {
+        EFLedKernels::scale16(linear, scaled, NUM_BADGE * 3, i | 0x8000);
+        EFBenchmark::clobber(scaled);
+    }));
+    EFBenchmark::report("blendAlpha", EFBenchmark::perFrame([&](uint32_t) {
+        EFLedKernels::blendAlpha(out, b, alpha, NUM_BADGE);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("addAlpha", EFBenchmark::perFrame([&](uint32_t) {
+        EFLedKernels::addAlpha(out, b, alpha, NUM_BADGE);
+        EFBenchmark::clobber(out);
+    }));
+    EFBenchmark::report("multiplyAlpha", EFBenchmark::perFrame([&](uint32_t) {
+        EFLedKernels::multiplyAlpha(out, b, alpha, NUM_BADGE);
+        EFBenchmark::clobber(out);
+    }));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fastled_semantics);
+    RUN_TEST(test_blend_matches_reference);
+    RUN_TEST(test_blend_aliasing);
+    RUN_TEST(test_blend_bounds);
+    RUN_TEST(test_uniform_kernels);
+    RUN_TEST(test_linear_kernels);
+    RUN_TEST(test_alpha_kernels);
+    RUN_TEST(test_alpha_kernels_bounds);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}